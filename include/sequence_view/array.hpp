@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <sequence_view/parallel.hpp>
+#include <sequence_view/view.hpp>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace SeqView {
+constexpr std::size_t CACHE_LINE = 64;
+// Size of transparent huge page, allocations using them are aligned and
+// padded to it, so the kernel can back them with whole huge pages
+constexpr std::size_t HUGE_PAGE = std::size_t(2) << 20;
+
+enum class Pages { Default, Huge };
+
+// Owning buffer aligned to Align bytes, elements are constructed in chunks
+// split as in parallel algorithms, so with the same threads every chunk
+// lands on memory first touched by the thread that is going to process it
+template <typename T, std::size_t Align = CACHE_LINE>
+class Array {
+  static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0,
+                "Alignment has to be a power of two not weaker than type's");
+
+ public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+  using const_reference = T const&;
+
+  Array() = default;
+
+  // Value initialized elements
+  explicit Array(uint64_t size, Pages pages = Pages::Default,
+                 Threads threads = {})
+      : _ptr(allocate(size, pages)), _size(size), _pages(pages) {
+    parallel_for(size, threads.workers(size),
+                 [this](uint64_t, uint64_t first, uint64_t last) {
+                   std::uninitialized_value_construct(_ptr + first,
+                                                      _ptr + last);
+                 });
+  }
+
+  Array(uint64_t size, const T& value, Pages pages = Pages::Default,
+        Threads threads = {})
+      : _ptr(allocate(size, pages)), _size(size), _pages(pages) {
+    parallel_for(size, threads.workers(size),
+                 [this, &value](uint64_t, uint64_t first, uint64_t last) {
+                   std::uninitialized_fill(_ptr + first, _ptr + last, value);
+                 });
+  }
+
+  Array(Array&& other) noexcept
+      : _ptr(std::exchange(other._ptr, nullptr)),
+        _size(std::exchange(other._size, 0)),
+        _pages(other._pages) {}
+
+  Array& operator=(Array&& other) noexcept {
+    if (this != &other) {
+      release();
+      _ptr = std::exchange(other._ptr, nullptr);
+      _size = std::exchange(other._size, 0);
+      _pages = other._pages;
+    }
+    return *this;
+  }
+
+  Array(const Array&) = delete;
+  Array& operator=(const Array&) = delete;
+
+  ~Array() { release(); }
+
+  constexpr static std::size_t alignment() { return Align; }
+
+  uint64_t size() const { return _size; }
+
+  bool empty() const { return _size == 0; }
+
+  Pages pages() const { return _pages; }
+
+  // Alignment is promised to the compiler, so kernels can use aligned loads
+  pointer data() const { return std::assume_aligned<Align>(_ptr); }
+
+  pointer begin() const { return data(); }
+  pointer end() const { return data() + _size; }
+
+  reference operator[](uint64_t idx) { return data()[idx]; }
+  const_reference operator[](uint64_t idx) const { return data()[idx]; }
+
+  View<T> view(std::pmr::memory_resource* resource =
+                   std::pmr::get_default_resource()) const {
+    return View<T>(data(), _size, STEP, resource);
+  }
+
+  operator View<T>() const { return view(); }
+  operator View<const T>() const { return View<const T>(data(), _size); }
+
+ private:
+  static std::size_t page_alignment(Pages pages) {
+    return pages == Pages::Huge ? std::max(Align, HUGE_PAGE) : Align;
+  }
+
+  static std::size_t bytes(uint64_t size, Pages pages) {
+    auto align = page_alignment(pages);
+    return (size * sizeof(T) + align - 1) / align * align;
+  }
+
+  static pointer allocate(uint64_t size, Pages pages) {
+    if (size == 0) return nullptr;
+    auto length = bytes(size, pages);
+    auto ptr = ::operator new(length, std::align_val_t(page_alignment(pages)));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Only a hint, memory stays usable when huge pages are not available
+    if (pages == Pages::Huge) madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+    return static_cast<pointer>(ptr);
+  }
+
+  void release() {
+    if (_ptr == nullptr) return;
+    std::destroy(_ptr, _ptr + _size);
+    ::operator delete(_ptr, bytes(_size, _pages),
+                      std::align_val_t(page_alignment(_pages)));
+  }
+
+  pointer _ptr = nullptr;
+  uint64_t _size = 0;
+  Pages _pages = Pages::Default;
+};
+}  // namespace SeqView
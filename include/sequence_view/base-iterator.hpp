@@ -1,10 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <sequence_view/mask.hpp>
 #include <sequence_view/range.hpp>
+#include <type_traits>
 
 namespace SeqView {
+// Pointer moved by a number of bytes, lets views step over whole records
+template <typename T>
+T* offset_bytes(T* ptr, int64_t bytes) {
+  using Byte =
+      std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+  return reinterpret_cast<T*>(reinterpret_cast<Byte*>(ptr) + bytes);
+}
+
+template <typename T>
+int64_t bytes_between(const T* from, const T* to) {
+  return reinterpret_cast<const std::byte*>(to) -
+         reinterpret_cast<const std::byte*>(from);
+}
 
 template <typename T>
 struct BaseIterator {
@@ -16,8 +31,14 @@ struct BaseIterator {
 
   BaseIterator() = default;
 
-  BaseIterator(T* data, int64_t step = STEP, MaskInfo mask = {})
-      : _data(data), _step(step), _dstep(step < 0 ? step : 0), _mask(mask) {}
+  // Pitch is the distance in bytes between adjacent positions
+  BaseIterator(T* data, int64_t step = STEP, MaskInfo mask = {},
+               int64_t pitch = sizeof(T))
+      : _data(data),
+        _step(step),
+        _dstep(step < 0 ? step : 0),
+        _pitch(pitch),
+        _mask(mask) {}
 
   BaseIterator& operator++() {
     next_advance();
@@ -94,9 +115,9 @@ struct BaseIterator {
   }
 
   friend BaseIterator operator-(const BaseIterator& it, difference_type steps) {
-    uint64_t steps_abs = static_cast<uint64_t>(std::abs(steps));
-    return BaseIterator<T>(
-        steps >= 0 ? it.previous(steps_abs) : it.next(steps_abs), it._step);
+    auto copy = it;
+    copy -= steps;
+    return copy;
   }
 
   friend difference_type operator-(const BaseIterator<T>& lhs,
@@ -104,43 +125,48 @@ struct BaseIterator {
     return lhs._mask.good()
                ? static_cast<difference_type>(lhs._mask.valid()) -
                      static_cast<difference_type>(rhs._mask.valid())
-               : (lhs._data + lhs._dstep - rhs._data - rhs._dstep) / lhs._step;
+               : bytes_between(rhs._data, lhs._data) /
+                     (lhs._pitch * lhs._step);
   }
 
   reference operator*() const { return *ptr(); }
   pointer operator->() const { return ptr(); }
   reference operator[](difference_type steps) const {
     uint64_t steps_abs = static_cast<uint64_t>(std::abs(steps));
-    if (steps < 0) return *(previous(steps_abs) + _dstep);
-    return *(next(steps_abs) + _dstep);
+    if (steps < 0) return *advance(previous(steps_abs), _dstep);
+    return *advance(next(steps_abs), _dstep);
   }  // TODO Check
   pointer base() const { return ptr(); }
 
  protected:
-  T* ptr() const { return _data + _dstep; }
+  T* ptr() const { return advance(_data, _dstep); }
+
+  pointer advance(pointer ptr, int64_t positions) const {
+    return offset_bytes(ptr, positions * _pitch);
+  }
 
   pointer next(uint64_t steps = 1) const {
     auto jump =
         _step != MASK ? static_cast<int64_t>(steps) * _step : next_mask(steps);
-    return _data + jump;
+    return advance(_data, jump);
   }
 
   pointer previous(uint64_t steps = 1) const {
     auto jump = _step != MASK ? static_cast<int64_t>(steps) * _step
                               : previous_mask(steps);
-    return _data - jump;
+    return advance(_data, -jump);
   }
 
   pointer next_advance(uint64_t steps = 1) {
     auto ptr = next(steps);
-    _mask += (ptr - _data);
+    _mask += bytes_between(_data, ptr) / _pitch;
     _data = ptr;
     return _data;
   }
 
   pointer previous_advance(uint64_t steps = 1) {
     auto ptr = previous(steps);
-    _mask += (ptr - _data);
+    _mask += bytes_between(_data, ptr) / _pitch;
     _data = ptr;
     return _data;
   }
@@ -155,6 +181,7 @@ struct BaseIterator {
   T* _data = nullptr;
   int64_t _step = STEP;
   int64_t _dstep = 0;
+  int64_t _pitch = sizeof(T);
   MaskInfo _mask;
 };
 }  // namespace SeqView
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace SeqView {
+// Loops over fixed views up to this size are unrolled explicitly, longer ones
+// are left to the compiler, which still knows their trip count
+constexpr std::size_t FIXED_UNROLL = 64;
+
+// N elements Step apart, size and step are part of the type as in
+// std::span<T, N>. The view is a single pointer to the lowest viewed address
+// (as the pointer given to View), so it is cheap to create in inner loops,
+// and all loops over it have a known trip count
+template <typename T, std::size_t N, int64_t Step = STEP>
+class FixedView {
+  static_assert(Step != MASK, "Fixed views can not be masked");
+
+ public:
+  using size_type = std::size_t;
+  using value_type = std::remove_cv_t<T>;
+  using pointer = T*;
+  using reference = T&;
+  using const_reference = T const&;
+
+  // Elements are visited by index, so pointers never leave the viewed memory
+  class strided_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr strided_iterator() = default;
+    constexpr strided_iterator(pointer first, difference_type idx)
+        : _first(first), _idx(idx) {}
+
+    constexpr reference operator*() const { return _first[_idx * Step]; }
+    constexpr pointer operator->() const { return &**this; }
+    constexpr reference operator[](difference_type n) const {
+      return _first[(_idx + n) * Step];
+    }
+
+    constexpr strided_iterator& operator++() { return *this += 1; }
+    constexpr strided_iterator& operator--() { return *this -= 1; }
+    constexpr strided_iterator operator++(int) {
+      return std::exchange(*this, *this + 1);
+    }
+    constexpr strided_iterator operator--(int) {
+      return std::exchange(*this, *this - 1);
+    }
+
+    constexpr strided_iterator& operator+=(difference_type n) {
+      _idx += n;
+      return *this;
+    }
+    constexpr strided_iterator& operator-=(difference_type n) {
+      _idx -= n;
+      return *this;
+    }
+    constexpr strided_iterator operator+(difference_type n) const {
+      return strided_iterator(_first, _idx + n);
+    }
+    constexpr strided_iterator operator-(difference_type n) const {
+      return strided_iterator(_first, _idx - n);
+    }
+    friend constexpr strided_iterator operator+(difference_type n,
+                                                const strided_iterator& it) {
+      return it + n;
+    }
+    constexpr difference_type operator-(const strided_iterator& other) const {
+      return _idx - other._idx;
+    }
+
+    constexpr bool operator==(const strided_iterator& other) const {
+      return _idx == other._idx;
+    }
+    constexpr auto operator<=>(const strided_iterator& other) const {
+      return _idx <=> other._idx;
+    }
+
+   private:
+    pointer _first = nullptr;
+    difference_type _idx = 0;
+  };
+
+  // Dense views iterate with plain pointers
+  using iterator = std::conditional_t<Step == STEP, pointer, strided_iterator>;
+  using const_iterator = iterator;
+
+  // Memory covered by the view, counted in elements from the lowest address
+  constexpr static uint64_t EXTENT =
+      N * static_cast<uint64_t>(Step < 0 ? -Step : Step);
+  static_assert(View<T>::elements(EXTENT, Step) == N || N == 0,
+                "Extent has to hold exactly N elements");
+  // Offset of the first element in view order from the lowest address, as
+  // View::base_ptr computes at runtime
+  constexpr static uint64_t FIRST = Step > 0 || N == 0 ? 0 : EXTENT + Step;
+
+  constexpr FixedView() = default;
+
+  // ptr is the lowest viewed address, as for View
+  constexpr explicit FixedView(pointer ptr) : _ptr(ptr) {}
+
+  constexpr FixedView(const FixedView&) = default;
+
+  template <std::size_t M>
+  constexpr FixedView(T (&array)[M]) : _ptr(array) {
+    static_assert(M >= EXTENT, "Array is smaller than the view");
+  }
+
+  template <typename U>
+    requires std::is_convertible_v<U (*)[], T (*)[]>
+  constexpr FixedView(const FixedView<U, N, Step>& other)
+      : _ptr(other.origin()) {}
+
+  constexpr static uint64_t size() { return N; }
+
+  constexpr static int64_t step() { return Step; }
+
+  constexpr static bool contiguous() { return Step == STEP; }
+
+  // Address of the first element
+  constexpr pointer data() const { return _ptr + FIRST; }
+
+  constexpr pointer origin() const { return _ptr; }
+
+  constexpr reference operator[](uint64_t idx) const {
+    return data()[static_cast<int64_t>(idx) * Step];
+  }
+
+  constexpr iterator begin() const {
+    if constexpr (Step == STEP)
+      return _ptr;
+    else
+      return iterator(data(), 0);
+  }
+
+  constexpr iterator end() const {
+    if constexpr (Step == STEP)
+      return _ptr + N;
+    else
+      return iterator(data(), static_cast<std::ptrdiff_t>(N));
+  }
+
+  constexpr const_iterator cbegin() const { return begin(); }
+  constexpr const_iterator cend() const { return end(); }
+
+  // M elements starting with element first, every S-th one
+  template <std::size_t M, int64_t S = STEP>
+  constexpr FixedView<T, M, Step * S> subview(uint64_t first) const {
+    static_assert(S > 0, "Reverse the view by its own step");
+    if constexpr (M == 0) {
+      return FixedView<T, 0, Step * S>(data());
+    } else {
+      auto lowest = Step > 0 ? first : first + (M - 1) * S;
+      return FixedView<T, M, Step * S>(&(*this)[lowest]);
+    }
+  }
+
+  // Visit elements in view order, unrolled for small views
+  template <typename Func>
+  constexpr void for_each(Func&& func) const {
+    if constexpr (N <= FIXED_UNROLL) {
+      [&]<std::size_t... Idx>(std::index_sequence<Idx...>) {
+        (func((*this)[Idx]), ...);
+      }(std::make_index_sequence<N>());
+    } else {
+      for (uint64_t idx = 0; idx < N; ++idx) func((*this)[idx]);
+    }
+  }
+
+  template <typename Acc, typename Op>
+  constexpr Acc reduce(Acc init, Op op) const {
+    for_each([&init, &op](const T& elem) { init = op(init, elem); });
+    return init;
+  }
+
+  constexpr std::array<value_type, N> gather() const {
+    std::array<value_type, N> out{};
+    auto dst = out.begin();
+    for_each([&dst](const T& elem) { *dst++ = elem; });
+    return out;
+  }
+
+  constexpr void scatter(const std::array<value_type, N>& in) const {
+    auto src = in.begin();
+    for_each([&src](T& elem) { elem = *src++; });
+  }
+
+  constexpr const T& operator=(const T& value) {
+    for_each([&value](T& elem) { elem = value; });
+    return value;
+  }
+
+  // Elements are copied through a local array, so views may overlap
+  template <typename U, int64_t S>
+  constexpr const FixedView<U, N, S>& operator=(
+      const FixedView<U, N, S>& value) {
+    auto values = value.gather();
+    auto src = values.begin();
+    for_each([&src](T& elem) { elem = *src++; });
+    return value;
+  }
+
+  constexpr const FixedView& operator=(const FixedView& value) {
+    scatter(value.gather());
+    return value;
+  }
+
+  View<T> view(std::pmr::memory_resource* resource =
+                    std::pmr::get_default_resource()) const {
+    return View<T>(_ptr, EXTENT, Step, resource);
+  }
+
+  operator View<T>() const { return view(); }
+
+ private:
+  pointer _ptr = nullptr;
+};
+
+template <typename T, std::size_t M>
+FixedView(T (&)[M]) -> FixedView<T, M>;
+}  // namespace SeqView
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <sequence_view/parallel.hpp>
+#include <sequence_view/view.hpp>
+#include <span>
+#include <type_traits>
+
+namespace SeqView {
+using Counts = std::pmr::vector<uint64_t>;
+
+namespace detail {
+// Increments rotate over private sub histograms, so consecutive equal values
+// do not wait for each other's store
+constexpr uint64_t SUB_HISTOGRAMS = 4;
+// Bins are computed for a whole batch before any increment
+constexpr uint64_t BIN_BATCH = 64;
+
+struct UniformBins {
+  double lo;
+  double hi;
+  double scale;
+  uint64_t nbins;
+
+  template <typename T>
+  uint64_t operator()(const T& elem) const {
+    auto value = static_cast<double>(elem);
+    auto in_range = value >= lo && value <= hi;
+    auto pos = in_range ? (value - lo) * scale : 0.0;
+    // Upper edge belongs to the last bin
+    auto bin = std::min(static_cast<uint64_t>(pos), nbins - 1);
+    return in_range ? bin : nbins;
+  }
+};
+
+struct EdgeBins {
+  std::span<const double> edges;
+
+  template <typename T>
+  uint64_t operator()(const T& elem) const {
+    auto nbins = edges.size() - 1;
+    auto value = static_cast<double>(elem);
+    if (!(value >= edges.front() && value <= edges.back())) return nbins;
+    auto bin = std::upper_bound(edges.begin(), edges.end(), value) -
+               edges.begin() - 1;
+    return std::min(static_cast<uint64_t>(bin), nbins - 1);
+  }
+};
+
+struct IndexBins {
+  uint64_t nbins;
+
+  template <typename T>
+  uint64_t operator()(const T& elem) const {
+    if constexpr (std::is_signed_v<T>)
+      if (elem < 0) return nbins;
+    auto bin = static_cast<uint64_t>(elem);
+    return bin < nbins ? bin : nbins;
+  }
+};
+
+// Count positions [first, last) of view into SUB_HISTOGRAMS rows of stride
+// bins, the last bin of every row collects values outside of the range
+template <typename T, typename Binner>
+void fill_bins(const View<T>& view, uint64_t first, uint64_t last,
+               const Binner& binner, uint64_t* bins, uint64_t stride) {
+  std::array<uint64_t, BIN_BATCH> batch;
+  uint64_t filled = 0;
+  auto flush = [&] {
+    for (uint64_t idx = 0; idx < filled; ++idx)
+      ++bins[(idx % SUB_HISTOGRAMS) * stride + batch[idx]];
+    filled = 0;
+  };
+
+  if (view.contiguous()) {
+    auto data = view.data();
+    for (auto pos = first; pos < last; pos += BIN_BATCH) {
+      filled = std::min(BIN_BATCH, last - pos);
+      for (uint64_t idx = 0; idx < filled; ++idx)
+        batch[idx] = binner(data[pos + idx]);
+      flush();
+    }
+    return;
+  }
+  view.for_each(
+      [&](const T& elem) {
+        batch[filled++] = binner(elem);
+        if (filled == BIN_BATCH) flush();
+      },
+      first, last);
+  flush();
+}
+
+template <typename T, typename Binner>
+Counts count_bins(const View<T>& view, uint64_t nbins, const Binner& binner,
+                  Threads threads) {
+  Counts counts(nbins, view.resource());
+  if (nbins == 0) return counts;
+
+  auto stride = nbins + 1;
+  auto workers = threads.workers(view.extent());
+  auto rows = workers * SUB_HISTOGRAMS;
+  // Allocated up front, memory resources are not meant to be shared by threads
+  Counts partial(rows * stride, view.resource());
+  parallel_for(view.extent(), workers,
+               [&](uint64_t worker, uint64_t first, uint64_t last) {
+                 fill_bins(view, first, last, binner,
+                           partial.data() + worker * SUB_HISTOGRAMS * stride,
+                           stride);
+               });
+
+  auto merge = [&](uint64_t, uint64_t first, uint64_t last) {
+    for (uint64_t row = 0; row < rows; ++row)
+      for (auto bin = first; bin < last; ++bin)
+        counts[bin] += partial[row * stride + bin];
+  };
+  parallel_for(nbins, threads.workers(nbins * rows), merge);
+  return counts;
+}
+}  // namespace detail
+
+// Count elements in nbins equal bins over [lo, hi], values outside are ignored
+template <typename T>
+Counts histogram(const View<T>& view, uint64_t nbins, double lo, double hi,
+                 Threads threads = {}) {
+  if (!(lo < hi)) return Counts(nbins, view.resource());
+  auto scale = static_cast<double>(nbins) / (hi - lo);
+  return detail::count_bins(view, nbins,
+                            detail::UniformBins{lo, hi, scale, nbins}, threads);
+}
+
+// Count elements in bins [edges[i], edges[i + 1]), the last bin includes its
+// upper edge, edges have to be sorted
+template <typename T>
+Counts histogram(const View<T>& view, std::span<const double> edges,
+                 Threads threads = {}) {
+  if (edges.size() < 2) return Counts(view.resource());
+  return detail::count_bins(view, edges.size() - 1, detail::EdgeBins{edges},
+                            threads);
+}
+
+// Count occurrences of every non negative value, result has at least
+// minlength bins, negative values are ignored
+template <typename T>
+Counts bincount(const View<T>& view, uint64_t minlength = 0,
+                Threads threads = {}) {
+  static_assert(std::is_integral_v<T>, "bincount requires integral values");
+  uint64_t nbins = minlength;
+  view.for_each([&nbins](const T& elem) {
+    if constexpr (std::is_signed_v<T>)
+      if (elem < 0) return;
+    nbins = std::max(nbins, static_cast<uint64_t>(elem) + 1);
+  });
+  return detail::count_bins(view, nbins, detail::IndexBins{nbins}, threads);
+}
+}  // namespace SeqView
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/scratch.hpp>
+#include <sequence_view/view.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace SeqView {
+// Positions of elements in the buffer, counted in elements (records for
+// field views) from its beginning
+using Indices = std::pmr::vector<uint64_t>;
+
+namespace detail {
+// Buffer starts at base when given, otherwise at the lowest viewed address
+template <typename T>
+const T* buffer_begin(const View<T>& view, const T* base) {
+  return base != nullptr ? base : view.origin();
+}
+
+template <typename T>
+uint64_t position_of(const View<T>& view, const T* base, const T* elem) {
+  return static_cast<uint64_t>(bytes_between(base, elem) / view.pitch());
+}
+
+// Position of the first element no other one is preferred to
+template <typename T, typename Prefer>
+std::optional<uint64_t> arg_best(const View<T>& view, const T* base,
+                                 Prefer prefer) {
+  if (view.size() == 0) return std::nullopt;
+  base = buffer_begin(view, base);
+  if (view.contiguous()) {
+    auto data = view.data();
+    uint64_t best = 0;
+    for (uint64_t idx = 1; idx < view.size(); ++idx)
+      if (prefer(data[idx], data[best])) best = idx;
+    return position_of(view, base, data + best);
+  }
+  const T* best = nullptr;
+  view.for_each([&best, &prefer](const T& elem) {
+    if (best == nullptr || prefer(elem, *best)) best = &elem;
+  });
+  return position_of(view, base, best);
+}
+
+// Predicate of 64 consecutive elements is evaluated into a bit mask without
+// branches, so compilers can vectorize it, positions are then extracted from
+// set bits only
+template <typename T, typename Predicate>
+void compact_dense(const T* data, uint64_t size, uint64_t first,
+                   Predicate& pred, Indices& out) {
+  constexpr uint64_t BLOCK = 64;
+  for (uint64_t start = 0; start < size; start += BLOCK) {
+    auto count = std::min(BLOCK, size - start);
+    uint64_t bits = 0;
+    for (uint64_t idx = 0; idx < count; ++idx) {
+      auto match = static_cast<bool>(pred(data[start + idx]));
+      bits |= static_cast<uint64_t>(match) << idx;
+    }
+    auto filled = out.size();
+    out.resize(filled + static_cast<uint64_t>(std::popcount(bits)));
+    for (; bits != 0; bits &= bits - 1)
+      out[filled++] = first + start + std::countr_zero(bits);
+  }
+}
+}  // namespace detail
+
+// Position of the smallest element, the first one for ties
+template <typename T, typename Compare = std::less<>>
+std::optional<uint64_t> argmin(const View<T>& view,
+                               std::type_identity_t<const T*> base = nullptr,
+                               Compare comp = {}) {
+  return detail::arg_best(view, base, comp);
+}
+
+// Position of the largest element, the first one for ties
+template <typename T, typename Compare = std::less<>>
+std::optional<uint64_t> argmax(const View<T>& view,
+                               std::type_identity_t<const T*> base = nullptr,
+                               Compare comp = {}) {
+  return detail::arg_best(view, base, [&comp](const T& lhs, const T& rhs) {
+    return comp(rhs, lhs);
+  });
+}
+
+// Positions of elements matching predicate in view order
+template <typename T, typename Predicate>
+Indices where(const View<T>& view, Predicate pred,
+              std::type_identity_t<const T*> base = nullptr) {
+  Indices indices(view.resource());
+  if (view.size() == 0) return indices;
+  base = detail::buffer_begin(view, base);
+  if (view.contiguous()) {
+    detail::compact_dense(view.data(), view.size(),
+                          detail::position_of(view, base, view.data()), pred,
+                          indices);
+    return indices;
+  }
+  view.for_each([&](const T& elem) {
+    if (pred(elem)) indices.push_back(detail::position_of(view, base, &elem));
+  });
+  return indices;
+}
+
+// Positions of elements not equal to zero (value initialized T)
+template <typename T>
+Indices nonzero(const View<T>& view,
+                std::type_identity_t<const T*> base = nullptr) {
+  using Value = std::remove_const_t<T>;
+  return where(
+      view, [](const T& elem) { return elem != Value{}; }, base);
+}
+
+// Positions of k elements coming first in comp order (the largest ones by
+// default) sorted by that order, ties are resolved by position. Small k keeps
+// a bounded heap, larger ones partition all elements
+template <typename T, typename Compare = std::greater<>>
+Indices top_k(const View<T>& view, uint64_t k, Compare comp = {},
+              std::type_identity_t<const T*> base = nullptr) {
+  using Entry = std::pair<std::remove_const_t<T>, uint64_t>;
+  Indices indices(view.resource());
+  k = std::min(k, view.size());
+  if (k == 0) return indices;
+  base = detail::buffer_begin(view, base);
+  auto better = [&comp](const Entry& lhs, const Entry& rhs) {
+    if (comp(lhs.first, rhs.first)) return true;
+    return !comp(rhs.first, lhs.first) && lhs.second < rhs.second;
+  };
+
+  std::span<Entry> entries;
+  if (k * 8 < view.size()) {
+    // Front of the heap is the worst of kept entries
+    entries = scratch<Entry>(k);
+    uint64_t kept = 0;
+    view.for_each([&](const T& elem) {
+      Entry entry(elem, detail::position_of(view, base, &elem));
+      if (kept < k) {
+        entries[kept++] = entry;
+        std::push_heap(entries.begin(), entries.begin() + kept, better);
+      } else if (better(entry, entries.front())) {
+        std::pop_heap(entries.begin(), entries.end(), better);
+        entries.back() = entry;
+        std::push_heap(entries.begin(), entries.end(), better);
+      }
+    });
+  } else {
+    auto all = scratch<Entry>(view.size());
+    auto entry = all.begin();
+    view.for_each([&](const T& elem) {
+      *entry++ = Entry(elem, detail::position_of(view, base, &elem));
+    });
+    std::nth_element(all.begin(), all.begin() + static_cast<int64_t>(k - 1),
+                     all.end(), better);
+    entries = all.first(k);
+  }
+  std::sort(entries.begin(), entries.end(), better);
+  indices.resize(k);
+  for (uint64_t idx = 0; idx < k; ++idx) indices[idx] = entries[idx].second;
+  return indices;
+}
+}  // namespace SeqView
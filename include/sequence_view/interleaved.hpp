@@ -0,0 +1,200 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <sequence_view/view.hpp>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SeqView {
+namespace detail {
+#if defined(__SSE2__)
+// Shuffles only move bits, so every 4 byte sample is handled as float
+template <typename T, std::size_t Channels>
+constexpr bool sse_interleavable = sizeof(T) == sizeof(float) &&
+                                   std::is_trivially_copyable_v<T> &&
+                                   (Channels == 2 || Channels == 4);
+
+inline __m128 load_lanes(const void* ptr) {
+  return _mm_loadu_ps(static_cast<const float*>(ptr));
+}
+
+inline void store_lanes(void* ptr, __m128 reg) {
+  _mm_storeu_ps(static_cast<float*>(ptr), reg);
+}
+
+// 4 frames per iteration, 2 channels are split by shuffles and 4 channels by
+// 4x4 transpose, returns number of frames done
+template <std::size_t Channels, typename T>
+uint64_t sse_deinterleave(const T* in, const std::array<T*, Channels>& out,
+                          uint64_t frames) {
+  uint64_t frame = 0;
+  for (; frame + 4 <= frames; frame += 4) {
+    auto src = in + frame * Channels;
+    if constexpr (Channels == 2) {
+      auto lo = load_lanes(src);
+      auto hi = load_lanes(src + 4);
+      store_lanes(out[0] + frame, _mm_shuffle_ps(lo, hi, 0x88));
+      store_lanes(out[1] + frame, _mm_shuffle_ps(lo, hi, 0xDD));
+    } else {
+      auto r0 = load_lanes(src);
+      auto r1 = load_lanes(src + 4);
+      auto r2 = load_lanes(src + 8);
+      auto r3 = load_lanes(src + 12);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      store_lanes(out[0] + frame, r0);
+      store_lanes(out[1] + frame, r1);
+      store_lanes(out[2] + frame, r2);
+      store_lanes(out[3] + frame, r3);
+    }
+  }
+  return frame;
+}
+
+template <std::size_t Channels, typename T>
+uint64_t sse_interleave(const std::array<const T*, Channels>& in, T* out,
+                        uint64_t frames) {
+  uint64_t frame = 0;
+  for (; frame + 4 <= frames; frame += 4) {
+    auto dst = out + frame * Channels;
+    if constexpr (Channels == 2) {
+      auto first = load_lanes(in[0] + frame);
+      auto second = load_lanes(in[1] + frame);
+      store_lanes(dst, _mm_unpacklo_ps(first, second));
+      store_lanes(dst + 4, _mm_unpackhi_ps(first, second));
+    } else {
+      auto r0 = load_lanes(in[0] + frame);
+      auto r1 = load_lanes(in[1] + frame);
+      auto r2 = load_lanes(in[2] + frame);
+      auto r3 = load_lanes(in[3] + frame);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      store_lanes(dst, r0);
+      store_lanes(dst + 4, r1);
+      store_lanes(dst + 8, r2);
+      store_lanes(dst + 12, r3);
+    }
+  }
+  return frame;
+}
+#endif
+
+template <std::size_t Channels, typename T>
+void deinterleave_dense(const T* in, const std::array<T*, Channels>& out,
+                        uint64_t frames) {
+  uint64_t frame = 0;
+#if defined(__SSE2__)
+  if constexpr (sse_interleavable<T, Channels>)
+    frame = sse_deinterleave<Channels>(in, out, frames);
+#endif
+  for (; frame < frames; ++frame)
+    for (std::size_t channel = 0; channel < Channels; ++channel)
+      out[channel][frame] = in[frame * Channels + channel];
+}
+
+template <std::size_t Channels, typename T>
+void interleave_dense(const std::array<const T*, Channels>& in, T* out,
+                      uint64_t frames) {
+  uint64_t frame = 0;
+#if defined(__SSE2__)
+  if constexpr (sse_interleavable<T, Channels>)
+    frame = sse_interleave<Channels>(in, out, frames);
+#endif
+  for (; frame < frames; ++frame)
+    for (std::size_t channel = 0; channel < Channels; ++channel)
+      out[frame * Channels + channel] = in[channel][frame];
+}
+}  // namespace detail
+
+// Buffer of frames with Channels samples each (RGB pixels, IQ samples,
+// multichannel audio), all channels are read or written in a single pass
+template <typename T, std::size_t Channels>
+class Interleaved {
+  static_assert(Channels > 0, "Interleaved requires at least one channel");
+
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+
+  Interleaved(pointer ptr, uint64_t frames) : _ptr(ptr), _frames(frames) {}
+
+  constexpr static std::size_t channels() { return Channels; }
+
+  uint64_t frames() const { return _frames; }
+
+  pointer data() const { return _ptr; }
+
+  reference operator()(uint64_t frame, std::size_t channel) const {
+    return _ptr[frame * Channels + channel];
+  }
+
+  // Samples of a single channel, every pass over it reads the whole buffer
+  View<T> channel(std::size_t channel) const {
+    if (_frames == 0 || channel >= Channels) return View<T>(_ptr, 0);
+    return View<T>(_ptr + channel, _frames * Channels - channel, Channels);
+  }
+
+  // Copy channels into views of frames() elements each, nothing is done when
+  // sizes differ
+  template <typename... Us>
+  void deinterleave(const View<Us>&... out) const {
+    static_assert(sizeof...(Us) == Channels, "View required for every channel");
+    if (((out.size() != _frames) || ...)) return;
+    using Sample = std::remove_const_t<T>;
+    if constexpr ((std::is_same_v<Us, Sample> && ...)) {
+      if ((out.contiguous() && ...)) {
+        detail::deinterleave_dense<Channels, Sample>(
+            _ptr, std::array<Sample*, Channels>{out.data()...}, _frames);
+        return;
+      }
+    }
+    std::tuple<BaseIterator<Us>...> its{out.begin()...};
+    for (uint64_t frame = 0; frame < _frames; ++frame) {
+      auto sample = _ptr + frame * Channels;
+      std::apply([&sample](auto&... it) { ((*it++ = *sample++), ...); }, its);
+    }
+  }
+
+  // Fill the buffer from views of frames() elements each, nothing is done
+  // when sizes differ
+  template <typename... Us>
+  void interleave(const View<Us>&... in) const {
+    static_assert(sizeof...(Us) == Channels, "View required for every channel");
+    if (((in.size() != _frames) || ...)) return;
+    if constexpr ((std::is_same_v<std::remove_const_t<Us>, T> && ...)) {
+      if ((in.contiguous() && ...)) {
+        detail::interleave_dense<Channels, T>(
+            std::array<const T*, Channels>{in.data()...}, _ptr, _frames);
+        return;
+      }
+    }
+    std::tuple<BaseIterator<Us>...> its{in.begin()...};
+    for (uint64_t frame = 0; frame < _frames; ++frame) {
+      auto sample = _ptr + frame * Channels;
+      std::apply([&sample](auto&... it) { ((*sample++ = *it++), ...); }, its);
+    }
+  }
+
+  // Reduction of every channel, acc[c] = op(acc[c], sample), memory is read
+  // once for all channels
+  template <typename Acc, typename Op>
+  std::array<Acc, Channels> reduce(std::array<Acc, Channels> acc,
+                                   Op op) const {
+    for (uint64_t frame = 0; frame < _frames; ++frame) {
+      auto sample = _ptr + frame * Channels;
+      for (std::size_t channel = 0; channel < Channels; ++channel)
+        acc[channel] = op(acc[channel], sample[channel]);
+    }
+    return acc;
+  }
+
+ private:
+  pointer _ptr = nullptr;
+  uint64_t _frames = 0;
+};
+}  // namespace SeqView
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <sequence_view/mask.hpp>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SeqView {
+// Bytes keep one MaskT per entry and are used in place, bits and runs are
+// smaller on disk but are expanded when loaded
+enum class MaskEncoding : uint32_t { Bytes = 0, Bits = 1, Runs = 2 };
+
+constexpr std::array<char, 8> MASK_MAGIC{'S', 'E', 'Q', 'M', 'A', 'S', 'K', 0};
+constexpr uint32_t MASK_VERSION = 1;
+// Sections of the file start at multiples of it, so mapped index can be read
+// in place
+constexpr uint64_t MASK_SECTION = 64;
+
+// File starts with the header, followed by the prefix index (MaskInfo's
+// valid_until) and the payload with entries. Integers are stored in native
+// byte order, offsets are counted from the beginning of the file
+struct MaskHeader {
+  std::array<char, 8> magic = MASK_MAGIC;
+  uint32_t version = MASK_VERSION;
+  MaskEncoding encoding = MaskEncoding::Bytes;
+  uint64_t entries = 0;
+  uint64_t block = MASK_BLOCK;
+  uint64_t index_offset = 0;
+  uint64_t index_size = 0;
+  uint64_t payload_offset = 0;
+  uint64_t payload_size = 0;
+};
+static_assert(std::is_trivially_copyable_v<MaskHeader> &&
+                  sizeof(MaskHeader) == 64,
+              "Mask header layout is part of the file format");
+
+namespace detail {
+constexpr uint64_t section_begin(uint64_t offset) {
+  return (offset + MASK_SECTION - 1) / MASK_SECTION * MASK_SECTION;
+}
+
+// Entries as bytes with only MASK_TRUE and MASK_FALSE values, 8 entries
+// packed into a byte starting from the lowest bit, or lengths of alternating
+// runs starting with a run of invalid entries
+inline std::vector<char> encode_mask(std::span<const MaskT> mask,
+                                     MaskEncoding encoding) {
+  std::vector<char> payload;
+  if (encoding == MaskEncoding::Bytes) {
+    payload.resize(mask.size());
+    for (uint64_t idx = 0; idx < mask.size(); ++idx)
+      payload[idx] = mask[idx] == MASK_TRUE ? MASK_TRUE : MASK_FALSE;
+  } else if (encoding == MaskEncoding::Bits) {
+    payload.resize((mask.size() + 7) / 8);
+    for (uint64_t idx = 0; idx < mask.size(); ++idx)
+      if (mask[idx] == MASK_TRUE)
+        payload[idx / 8] = static_cast<char>(payload[idx / 8] | (1 << idx % 8));
+  } else {
+    std::vector<uint64_t> runs;
+    bool valid = false;
+    uint64_t length = 0;
+    for (auto entry : mask) {
+      if ((entry == MASK_TRUE) != valid) {
+        runs.push_back(length);
+        valid = !valid;
+        length = 0;
+      }
+      ++length;
+    }
+    runs.push_back(length);
+    payload.resize(runs.size() * sizeof(uint64_t));
+    std::memcpy(payload.data(), runs.data(), payload.size());
+  }
+  return payload;
+}
+
+// Expanded entries, empty when payload does not describe entries of a mask
+inline Mask decode_mask(const char* payload, uint64_t size, uint64_t entries,
+                        MaskEncoding encoding,
+                        std::pmr::memory_resource* resource) {
+  Mask mask(resource);
+  if (encoding == MaskEncoding::Bits) {
+    if (size != (entries + 7) / 8) return mask;
+    mask.resize(entries);
+    for (uint64_t idx = 0; idx < entries; ++idx)
+      mask[idx] = (payload[idx / 8] >> idx % 8) & 1 ? MASK_TRUE : MASK_FALSE;
+    return mask;
+  }
+  if (size % sizeof(uint64_t) != 0) return mask;
+  mask.reserve(entries);
+  bool valid = false;
+  for (uint64_t offset = 0; offset < size; offset += sizeof(uint64_t)) {
+    uint64_t length;
+    std::memcpy(&length, payload + offset, sizeof(length));
+    if (length > entries - mask.size()) return Mask(resource);
+    mask.insert(mask.end(), length, valid ? MASK_TRUE : MASK_FALSE);
+    valid = !valid;
+  }
+  if (mask.size() != entries) return Mask(resource);
+  return mask;
+}
+
+// Read-only contents of a whole file, mapped into memory when the platform
+// allows it, otherwise read into a buffer
+class FileContents {
+ public:
+  explicit FileContents(const std::string& path) {
+#if defined(__unix__) || defined(__APPLE__)
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      auto size = static_cast<std::size_t>(info.st_size);
+      auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        _data = static_cast<const char*>(addr);
+        _size = size;
+      }
+    }
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return;
+    auto size = static_cast<std::size_t>(file.tellg());
+    // 8 byte words keep the index aligned
+    _buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(_buffer.data()),
+                   static_cast<std::streamsize>(size)))
+      return;
+    _data = reinterpret_cast<const char*>(_buffer.data());
+    _size = size;
+#endif
+  }
+
+  FileContents(const FileContents&) = delete;
+  FileContents& operator=(const FileContents&) = delete;
+
+  ~FileContents() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (_data != nullptr) ::munmap(const_cast<char*>(_data), _size);
+#endif
+  }
+
+  const char* data() const { return _data; }
+  uint64_t size() const { return _size; }
+
+ private:
+  const char* _data = nullptr;
+  uint64_t _size = 0;
+#if !(defined(__unix__) || defined(__APPLE__))
+  std::vector<uint64_t> _buffer;
+#endif
+};
+
+// Expanded entries of bits and runs, kept alive together with the file
+struct DecodedMask {
+  std::shared_ptr<const FileContents> file;
+  Mask entries;
+};
+}  // namespace detail
+
+// Store entries of the mask with its index, plain masks are indexed on the
+// way, false when file can not be written
+inline bool save_mask(const std::string& path, const MaskInfo& mask,
+                      MaskEncoding encoding = MaskEncoding::Bytes) {
+  std::span<const MaskT> entries(mask.begin,
+                                 static_cast<uint64_t>(mask.end - mask.begin));
+  auto payload = detail::encode_mask(entries, encoding);
+  MaskHeader header;
+  header.encoding = encoding;
+  header.entries = entries.size();
+  header.index_offset = detail::section_begin(sizeof(MaskHeader));
+  header.index_size = mask.valid_until.size();
+  header.payload_offset = detail::section_begin(
+      header.index_offset + header.index_size * sizeof(uint64_t));
+  header.payload_size = payload.size();
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) return false;
+  std::array<char, MASK_SECTION> padding{};
+  auto pad_to = [&](uint64_t offset) {
+    auto written = static_cast<uint64_t>(file.tellp());
+    file.write(padding.data(), static_cast<std::streamsize>(offset - written));
+  };
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  pad_to(header.index_offset);
+  auto index_bytes = header.index_size * sizeof(uint64_t);
+  file.write(reinterpret_cast<const char*>(mask.valid_until.data()),
+             static_cast<std::streamsize>(index_bytes));
+  pad_to(header.payload_offset);
+  file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+  return static_cast<bool>(file.flush());
+}
+
+// Mask stored by save_mask, the index is always used in place and so are the
+// entries of byte encoded masks. Views created from mask() keep the file
+// mapped as long as they or their iterators exist
+class MaskFile {
+ public:
+  explicit MaskFile(
+      const std::string& path,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    auto file = std::make_shared<const detail::FileContents>(path);
+    auto data = file->data();
+    if (data == nullptr || file->size() < sizeof(MaskHeader)) return;
+    std::memcpy(&_header, data, sizeof(MaskHeader));
+    if (!valid_header(file->size())) return;
+
+    std::span<const uint64_t> index(
+        reinterpret_cast<const uint64_t*>(data + _header.index_offset),
+        _header.index_size);
+    auto payload = data + _header.payload_offset;
+    if (_header.encoding == MaskEncoding::Bytes) {
+      std::span<const MaskT> entries(reinterpret_cast<const MaskT*>(payload),
+                                     _header.entries);
+      _info = MaskInfo(entries, index, std::move(file));
+      return;
+    }
+    auto decoded = std::make_shared<detail::DecodedMask>(
+        detail::DecodedMask{file, Mask(resource)});
+    decoded->entries = detail::decode_mask(payload, _header.payload_size,
+                                           _header.entries, _header.encoding,
+                                           resource);
+    if (decoded->entries.size() != _header.entries) return;
+    std::span<const MaskT> entries(decoded->entries);
+    _info = MaskInfo(entries, index, std::move(decoded));
+  }
+
+  // False for missing, truncated or incompatible files
+  bool good() const { return _info.storage != nullptr; }
+
+  MaskEncoding encoding() const { return _header.encoding; }
+
+  // Number of entries
+  uint64_t size() const { return _header.entries; }
+
+  uint64_t count() const { return _info.count(); }
+
+  // Mask to create views with View::from_mask
+  const MaskInfo& mask() const { return _info; }
+
+ private:
+  bool valid_header(uint64_t file_size) const {
+    const auto& h = _header;
+    auto blocks = (h.entries + MASK_BLOCK - 1) / MASK_BLOCK;
+    auto fits = [file_size](uint64_t offset, uint64_t size) {
+      return offset <= file_size && size <= file_size - offset;
+    };
+    return h.magic == MASK_MAGIC && h.version == MASK_VERSION &&
+           h.block == MASK_BLOCK && h.encoding <= MaskEncoding::Runs &&
+           h.index_offset % alignof(uint64_t) == 0 &&
+           h.index_size == blocks + 1 &&
+           fits(h.index_offset, h.index_size * sizeof(uint64_t)) &&
+           fits(h.payload_offset, h.payload_size) &&
+           (h.encoding != MaskEncoding::Bytes || h.payload_size == h.entries);
+  }
+
+  MaskHeader _header;
+  MaskInfo _info;
+};
+}  // namespace SeqView
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <sequence_view/parallel.hpp>
 #include <span>
 #include <vector>
 
@@ -8,37 +15,129 @@ namespace SeqView {
 using MaskT = uint8_t;
 constexpr MaskT MASK_TRUE = 1;
 constexpr MaskT MASK_FALSE = 0;
+// Number of mask entries summarized by single entry of the prefix index
+constexpr uint64_t MASK_BLOCK = 64;
+
+// Masks and their indexes allocate from a memory resource, so temporaries can
+// be taken from a per request arena and released at once
+using Mask = std::pmr::vector<MaskT>;
+using Prefix = std::pmr::vector<uint64_t>;
 
 struct MaskInfo {
   const MaskT* ptr = nullptr;
   const MaskT* begin = nullptr;
   const MaskT* end = nullptr;
   uint64_t cnt = 0;
-  std::vector<uint64_t> valid_until;
-
-  static std::vector<uint64_t> init_valid(const std::vector<MaskT>& span) {
-    std::vector<uint64_t> valids;
-    valids.resize(span.size() + 1);
-    uint64_t totals = 0;
-    for (uint64_t idx = 0; idx < span.size(); ++idx) {
-      totals += span.at(idx);
-      valids.at(idx + 1) = totals;
+  // Valid entries before every block of MASK_BLOCK entries, the last item is
+  // the total count
+  std::span<const uint64_t> valid_until;
+  // Keeps the index alive, together with entries of masks not owned by a
+  // view (e.g. mapped from a file). Shared by all copies (iterators)
+  std::shared_ptr<const void> storage;
+
+  // Count entries equal to MASK_TRUE, 8 of them at once in a 64 bit word
+  static uint64_t count_valid(const MaskT* mask, uint64_t size) {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t low_bits = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t total = 0;
+    uint64_t idx = 0;
+    for (; idx + sizeof(uint64_t) <= size; idx += sizeof(uint64_t)) {
+      uint64_t word;
+      std::memcpy(&word, mask + idx, sizeof(word));
+      // Bytes equal to MASK_TRUE become zero, the rest gets its top bit set
+      word ^= ones * MASK_TRUE;
+      auto non_zero = (word | ((word & low_bits) + low_bits)) & ~low_bits;
+      total += sizeof(uint64_t) -
+               static_cast<uint64_t>(std::popcount(non_zero));
     }
+    for (; idx < size; ++idx) total += mask[idx] == MASK_TRUE;
+    return total;
+  }
+
+  // Blocks are counted in parallel for large masks, then summed up
+  static Prefix init_valid(
+      std::span<const MaskT> span,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+      Threads threads = {}) {
+    auto blocks = (span.size() + MASK_BLOCK - 1) / MASK_BLOCK;
+    Prefix valids(blocks + 1, resource);
+    parallel_for(blocks, threads.workers(span.size()),
+                 [&](uint64_t, uint64_t first, uint64_t last) {
+                   for (auto block = first; block < last; ++block) {
+                     auto start = block * MASK_BLOCK;
+                     valids[block + 1] = count_valid(
+                         span.data() + start,
+                         std::min(MASK_BLOCK, span.size() - start));
+                   }
+                 });
+    std::partial_sum(valids.begin(), valids.end(), valids.begin());
     return valids;
   }
 
   MaskInfo() {}
 
-  MaskInfo(const std::vector<uint8_t>& span)
-      : ptr(&*span.begin()),
+  MaskInfo(
+      std::span<const MaskT> span,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+      Threads threads = {})
+      : ptr(span.data()), begin(ptr), end(ptr + span.size()) {
+    auto valids = std::allocate_shared<Prefix>(
+        std::pmr::polymorphic_allocator<Prefix>(resource),
+        init_valid(span, resource, threads));
+    valid_until = *valids;
+    storage = std::move(valids);
+    cnt = valid_until.back();
+  }
+
+  // Entries with index built before, both have to stay valid as long as
+  // storage is alive
+  MaskInfo(std::span<const MaskT> span, std::span<const uint64_t> valids,
+           std::shared_ptr<const void> owner)
+      : ptr(span.data()),
         begin(ptr),
         end(ptr + span.size()),
-        cnt(static_cast<uint64_t>(
-            std::count(span.begin(), span.end(), MASK_TRUE))),
-        valid_until(init_valid(span)) {}
+        cnt(valids.empty() ? 0 : valids.back()),
+        valid_until(valids),
+        storage(std::move(owner)) {}
+
+  template <typename Alloc>
+  MaskInfo(
+      const std::vector<MaskT, Alloc>& mask,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+      Threads threads = {})
+      : MaskInfo(std::span<const MaskT>(mask), resource, threads) {}
+
+  // Number of valid entries before position
+  uint64_t rank(uint64_t position) const {
+    auto block = position / MASK_BLOCK;
+    return valid_until[block] +
+           count_valid(begin + block * MASK_BLOCK, position % MASK_BLOCK);
+  }
+
+  // Position of valid entry with given ordinal, size of the mask if there is
+  // not that many
+  uint64_t select(uint64_t ordinal) const {
+    if (ordinal >= cnt) return static_cast<uint64_t>(end - begin);
+    const auto& valids = valid_until;
+    auto block = static_cast<uint64_t>(
+        std::upper_bound(valids.begin(), valids.end(), ordinal) -
+        valids.begin() - 1);
+    auto remaining = ordinal - valids[block];
+    auto current = begin + block * MASK_BLOCK;
+    for (;; ++current) {
+      if (*current != MASK_TRUE) continue;
+      if (remaining-- == 0) break;
+    }
+    return static_cast<uint64_t>(current - begin);
+  }
 
   int64_t next(uint64_t steps = 1) const {
     if (ptr == end) return 0;
+    auto position = static_cast<uint64_t>(ptr - begin);
+    if (steps > 1) {
+      auto target = select(rank(position + 1) + steps - 1);
+      return static_cast<int64_t>(target - position);
+    }
     auto current = ptr;
     while (steps != 0) {
       if (++current == end) break;
@@ -48,6 +147,12 @@ struct MaskInfo {
   }
 
   int64_t previous(uint64_t steps = 1) const {
+    auto position = static_cast<uint64_t>(ptr - begin);
+    if (steps > 1) {
+      auto before = rank(position);
+      if (before < steps) return static_cast<int64_t>(position);
+      return static_cast<int64_t>(position - select(before - steps));
+    }
     auto current = ptr;
     while (steps != 0 && current != begin) {
       --current;
@@ -56,8 +161,13 @@ struct MaskInfo {
     return ptr - current;
   }
 
-  uint64_t valid() const {
-    return valid_until.at(static_cast<uint64_t>(ptr - begin));
+  uint64_t valid() const { return rank(static_cast<uint64_t>(ptr - begin)); }
+
+  // Point to the same positions of a copy of the mask
+  void rebase(const MaskT* other) {
+    ptr = other + (ptr - begin);
+    end = other + (end - begin);
+    begin = other;
   }
 
   MaskInfo& operator+=(int64_t jump) {
@@ -77,4 +187,4 @@ struct MaskInfo {
     return ptr != nullptr && begin != nullptr && end != nullptr;
   }
 };
-}  // namespace SeqView
\ No newline at end of file
+}  // namespace SeqView
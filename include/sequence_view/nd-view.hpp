@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace SeqView {
+template <std::size_t Rank>
+using Shape = std::array<uint64_t, Rank>;
+// Distance between neighbours along every axis in elements, 0 repeats the
+// same elements (broadcasting), negative goes backwards
+template <std::size_t Rank>
+using Strides = std::array<int64_t, Rank>;
+
+namespace detail {
+// Odometer over all axes but the last one, inner(offsets, count, strides) is
+// called for every line along the last axis of all operands at once
+template <std::size_t Rank, std::size_t Operands, typename Inner>
+void walk(const Shape<Rank>& shape,
+          const std::array<Strides<Rank>, Operands>& strides, Inner&& inner) {
+  static_assert(Rank > 0, "Walk requires at least one axis");
+  for (auto dim : shape)
+    if (dim == 0) return;
+  std::array<int64_t, Operands> inner_strides;
+  for (std::size_t op = 0; op < Operands; ++op)
+    inner_strides[op] = strides[op][Rank - 1];
+
+  Shape<Rank> idx{};
+  std::array<int64_t, Operands> offsets{};
+  while (true) {
+    inner(offsets, shape[Rank - 1], inner_strides);
+    auto dim = static_cast<int64_t>(Rank) - 2;
+    for (; dim >= 0; --dim) {
+      auto axis = static_cast<std::size_t>(dim);
+      for (std::size_t op = 0; op < Operands; ++op)
+        offsets[op] += strides[op][axis];
+      if (++idx[axis] < shape[axis]) break;
+      for (std::size_t op = 0; op < Operands; ++op)
+        offsets[op] -= strides[op][axis] * static_cast<int64_t>(shape[axis]);
+      idx[axis] = 0;
+    }
+    if (dim < 0) return;
+  }
+}
+}  // namespace detail
+
+// Multi-dimensional view defined by pointer to first element, shape and
+// strides, transformations only change strides and never copy data
+template <typename T, std::size_t Rank>
+class NdView {
+ public:
+  static_assert(Rank > 0, "NdView requires at least one axis");
+  using size_type = std::size_t;
+  using value_type = T;
+  using pointer = T*;
+  using reference = T&;
+
+  // Strides of densely packed row major data with given step between
+  // elements of the last axis
+  constexpr static Strides<Rank> row_major(const Shape<Rank>& shape,
+                                           int64_t step = 1) {
+    Strides<Rank> strides{};
+    for (auto dim = Rank; dim-- > 0;) {
+      strides[dim] = step;
+      step *= static_cast<int64_t>(shape[dim]);
+    }
+    return strides;
+  }
+
+  NdView() = default;
+
+  NdView(pointer ptr, Shape<Rank> shape)
+      : NdView(ptr, shape, row_major(shape)) {}
+
+  NdView(pointer ptr, Shape<Rank> shape, Strides<Rank> strides)
+      : _ptr(ptr), _shape(shape), _strides(strides) {}
+
+  uint64_t size() const {
+    uint64_t total = 1;
+    for (auto dim : _shape) total *= dim;
+    return _ptr != nullptr ? total : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  const Shape<Rank>& shape() const { return _shape; }
+
+  const Strides<Rank>& strides() const { return _strides; }
+
+  pointer data() const { return _ptr; }
+
+  template <typename... Idx>
+  reference operator()(Idx... idx) const {
+    static_assert(sizeof...(Idx) == Rank, "Index required for every axis");
+    std::array<uint64_t, Rank> index{static_cast<uint64_t>(idx)...};
+    int64_t offset = 0;
+    for (std::size_t dim = 0; dim < Rank; ++dim)
+      offset += static_cast<int64_t>(index[dim]) * _strides[dim];
+    return _ptr[offset];
+  }
+
+  // New shape of the same elements, single axis can be -1 and is deduced
+  // from the others, empty view is returned for not matching sizes or when
+  // elements are not laid out in row major order
+  template <typename... Dims>
+  NdView<T, sizeof...(Dims)> reshape(Dims... dims) const {
+    constexpr auto NewRank = sizeof...(Dims);
+    std::array<int64_t, NewRank> requested{static_cast<int64_t>(dims)...};
+    if (_strides != row_major(_shape, _strides[Rank - 1])) return {};
+
+    Shape<NewRank> shape{};
+    uint64_t known = 1;
+    std::size_t deduced = NewRank;
+    for (std::size_t dim = 0; dim < NewRank; ++dim) {
+      if (requested[dim] == -1 && deduced == NewRank) {
+        deduced = dim;
+        continue;
+      }
+      if (requested[dim] < 0) return {};
+      shape[dim] = static_cast<uint64_t>(requested[dim]);
+      known *= shape[dim];
+    }
+    auto total = size();
+    if (deduced != NewRank) {
+      if (known == 0 || total % known != 0) return {};
+      shape[deduced] = total / known;
+      known *= shape[deduced];
+    }
+    if (known != total) return {};
+    return NdView<T, NewRank>(
+        _ptr, shape, NdView<T, NewRank>::row_major(shape, _strides[Rank - 1]));
+  }
+
+  // Axes in reversed order
+  NdView transpose() const {
+    auto shape = _shape;
+    auto strides = _strides;
+    std::reverse(shape.begin(), shape.end());
+    std::reverse(strides.begin(), strides.end());
+    return NdView(_ptr, shape, strides);
+  }
+
+  // Axis dim of the result is axis axes[dim] of this view
+  NdView permute(const std::array<std::size_t, Rank>& axes) const {
+    std::array<bool, Rank> used{};
+    Shape<Rank> shape;
+    Strides<Rank> strides;
+    for (std::size_t dim = 0; dim < Rank; ++dim) {
+      if (axes[dim] >= Rank || used[axes[dim]]) return {};
+      used[axes[dim]] = true;
+      shape[dim] = _shape[axes[dim]];
+      strides[dim] = _strides[axes[dim]];
+    }
+    return NdView(_ptr, shape, strides);
+  }
+
+  // Trailing axes are matched, axes of size 1 and missing leading axes are
+  // repeated with stride 0, empty view is returned for incompatible shapes
+  template <std::size_t NewRank>
+  NdView<T, NewRank> broadcast_to(const Shape<NewRank>& shape) const {
+    static_assert(NewRank >= Rank, "Broadcast can not remove axes");
+    Strides<NewRank> strides{};
+    constexpr auto leading = NewRank - Rank;
+    for (std::size_t dim = 0; dim < Rank; ++dim) {
+      auto target = shape[leading + dim];
+      if (_shape[dim] == target)
+        strides[leading + dim] = _strides[dim];
+      else if (_shape[dim] != 1)
+        return {};
+    }
+    return NdView<T, NewRank>(_ptr, shape, strides);
+  }
+
+  // Visit elements in row major order of the view
+  template <typename Func>
+  void for_each(Func&& func) const {
+    if (_ptr == nullptr) return;
+    detail::walk<Rank, 1>(
+        _shape, {_strides},
+        [&](const auto& offsets, uint64_t count, const auto& inner) {
+          auto ptr = _ptr + offsets[0];
+          for (uint64_t idx = 0; idx < count; ++idx)
+            func(ptr[static_cast<int64_t>(idx) * inner[0]]);
+        });
+  }
+
+ private:
+  pointer _ptr = nullptr;
+  Shape<Rank> _shape{};
+  Strides<Rank> _strides{};
+};
+
+// out = op(lhs, rhs) element wise, operands are broadcasted to shape of out
+// without copying, nothing is done for incompatible shapes
+template <typename T, std::size_t RankL, typename U, std::size_t RankR,
+          typename V, std::size_t Rank, typename Op>
+void transform(const NdView<T, RankL>& lhs, const NdView<U, RankR>& rhs,
+               const NdView<V, Rank>& out, Op op) {
+  auto left = lhs.broadcast_to(out.shape());
+  auto right = rhs.broadcast_to(out.shape());
+  if (left.data() == nullptr || right.data() == nullptr ||
+      out.data() == nullptr)
+    return;
+  detail::walk<Rank, 3>(
+      out.shape(), {left.strides(), right.strides(), out.strides()},
+      [&](const auto& offsets, uint64_t count, const auto& inner) {
+        auto a = left.data() + offsets[0];
+        auto b = right.data() + offsets[1];
+        auto o = out.data() + offsets[2];
+        // Common layouts get loops with constant strides to be vectorized
+        if (inner[0] == 1 && inner[1] == 1 && inner[2] == 1) {
+          for (uint64_t idx = 0; idx < count; ++idx)
+            o[idx] = op(a[idx], b[idx]);
+        } else if (inner[0] == 1 && inner[1] == 0 && inner[2] == 1) {
+          for (uint64_t idx = 0; idx < count; ++idx)
+            o[idx] = op(a[idx], *b);
+        } else if (inner[0] == 0 && inner[1] == 1 && inner[2] == 1) {
+          for (uint64_t idx = 0; idx < count; ++idx)
+            o[idx] = op(*a, b[idx]);
+        } else {
+          for (uint64_t idx = 0; idx < count; ++idx) {
+            auto pos = static_cast<int64_t>(idx);
+            o[pos * inner[2]] = op(a[pos * inner[0]], b[pos * inner[1]]);
+          }
+        }
+      });
+}
+
+// Element wise maximum of broadcasted operands
+template <typename T, std::size_t RankL, typename U, std::size_t RankR,
+          typename V, std::size_t Rank>
+void max(const NdView<T, RankL>& lhs, const NdView<U, RankR>& rhs,
+         const NdView<V, Rank>& out) {
+  transform(lhs, rhs, out,
+            [](const auto& a, const auto& b) { return a < b ? b : a; });
+}
+}  // namespace SeqView
@@ -0,0 +1,521 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/scratch.hpp>
+#include <sequence_view/view.hpp>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace SeqView {
+// Bulk operations unpack values into blocks of this size
+constexpr uint64_t PACKED_BLOCK = 256;
+
+namespace detail {
+template <unsigned Bits>
+using packed_t = std::conditional_t<
+    Bits <= 8, uint8_t, std::conditional_t<Bits <= 16, uint16_t, uint32_t>>;
+
+template <unsigned Bits>
+constexpr uint64_t PACKED_MASK = (uint64_t(1) << Bits) - 1;
+
+template <unsigned Bits>
+constexpr uint64_t packed_bytes(uint64_t count) {
+  return (count * Bits + 7) / 8;
+}
+
+// Up to 8 bytes starting at byte, those past the buffer are zero
+inline uint64_t load_word(const uint8_t* data, uint64_t bytes, uint64_t byte) {
+  uint64_t word = 0;
+  if (byte + sizeof(word) <= bytes)
+    std::memcpy(&word, data + byte, sizeof(word));
+  else
+    std::memcpy(&word, data + byte, bytes - byte);
+  return word;
+}
+
+template <unsigned Bits>
+packed_t<Bits> load_packed(const uint8_t* data, uint64_t bytes,
+                           uint64_t sample) {
+  auto bit = sample * Bits;
+  auto word = load_word(data, bytes, bit / 8);
+  return static_cast<packed_t<Bits>>((word >> bit % 8) & PACKED_MASK<Bits>);
+}
+
+// Only bytes holding bits of the sample are written
+template <unsigned Bits>
+void store_packed(uint8_t* data, uint64_t bytes, uint64_t sample,
+                  uint64_t value) {
+  auto bit = sample * Bits;
+  auto shift = bit % 8;
+  auto word = load_word(data, bytes, bit / 8);
+  word &= ~(PACKED_MASK<Bits> << shift);
+  word |= (value & PACKED_MASK<Bits>) << shift;
+  std::memcpy(data + bit / 8, &word, (shift + Bits + 7) / 8);
+}
+
+#if defined(__AVX2__)
+// 8 samples starting at a byte boundary take Bits bytes. Shuffle moves bytes
+// of every sample into its 32 bit lane (16 bytes are loaded into both halves
+// of the register), then lanes are shifted by bit offsets of samples
+template <unsigned Bits>
+struct GroupLayout {
+  std::array<int8_t, 32> shuffle{};
+  std::array<int32_t, 8> shifts{};
+
+  constexpr GroupLayout() {
+    for (unsigned lane = 0; lane < 8; ++lane) {
+      auto bit = lane * Bits;
+      auto first = bit / 8;
+      auto last = (bit + Bits - 1) / 8;
+      shifts[lane] = static_cast<int32_t>(bit % 8);
+      for (unsigned byte = 0; byte < 4; ++byte)
+        shuffle[lane / 4 * 16 + lane % 4 * 4 + byte] =
+            first + byte <= last ? static_cast<int8_t>(first + byte) : -128;
+    }
+  }
+};
+
+template <unsigned Bits>
+void unpack_groups(const uint8_t* in, uint64_t groups, packed_t<Bits>* out) {
+  static constexpr GroupLayout<Bits> layout;
+  auto shuffle = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(layout.shuffle.data()));
+  auto shifts = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(layout.shifts.data()));
+  auto mask = _mm256_set1_epi32(static_cast<int>(PACKED_MASK<Bits>));
+  for (uint64_t group = 0; group < groups; ++group, in += Bits, out += 8) {
+    auto bytes = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+    auto values = _mm256_and_si256(
+        _mm256_srlv_epi32(_mm256_shuffle_epi8(bytes, shuffle), shifts), mask);
+    auto words = _mm256_packus_epi32(values, values);
+    if constexpr (sizeof(packed_t<Bits>) == 2) {
+      words = _mm256_permute4x64_epi64(words, 0x08);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                       _mm256_castsi256_si128(words));
+    } else {
+      auto bytes_out = _mm256_packus_epi16(words, words);
+      auto low = _mm256_extract_epi32(bytes_out, 0);
+      auto high = _mm256_extract_epi32(bytes_out, 4);
+      std::memcpy(out, &low, sizeof(low));
+      std::memcpy(out + 4, &high, sizeof(high));
+    }
+  }
+}
+#endif
+
+// count samples starting at sample first, groups of 8 samples aligned to
+// bytes are unpacked at once with AVX2 for samples up to 16 bits
+template <unsigned Bits>
+void unpack_dense(const uint8_t* data, uint64_t bytes, uint64_t first,
+                  uint64_t count, packed_t<Bits>* out) {
+  uint64_t idx = 0;
+#if defined(__AVX2__)
+  if constexpr (Bits <= 16) {
+    for (; idx < count && (first + idx) % 8 != 0; ++idx)
+      out[idx] = load_packed<Bits>(data, bytes, first + idx);
+    auto byte = (first + idx) / 8 * Bits;
+    auto groups = (count - idx) / 8;
+    // Every group loads 16 bytes
+    if (byte + 16 > bytes)
+      groups = 0;
+    else
+      groups = std::min(groups, (bytes - byte - 16) / Bits + 1);
+    unpack_groups<Bits>(data + byte, groups, out + idx);
+    idx += groups * 8;
+  }
+#endif
+  for (; idx < count; ++idx)
+    out[idx] = load_packed<Bits>(data, bytes, first + idx);
+}
+
+// Samples between byte boundaries are written by a bit writer storing 32 bits
+// at once, partial bytes at both ends keep bits of neighbouring samples
+template <unsigned Bits>
+void pack_dense(uint8_t* data, uint64_t bytes, uint64_t first,
+                uint64_t count, const packed_t<Bits>* in) {
+  uint64_t idx = 0;
+  for (; idx < count && (first + idx) % 8 != 0; ++idx)
+    store_packed<Bits>(data, bytes, first + idx, in[idx]);
+  auto out = data + (first + idx) / 8 * Bits;
+  uint64_t acc = 0;
+  unsigned filled = 0;
+  for (auto whole = idx + (count - idx) / 8 * 8; idx < whole; ++idx) {
+    acc |= (in[idx] & PACKED_MASK<Bits>) << filled;
+    filled += Bits;
+    if (filled < 32) continue;
+    auto word = static_cast<uint32_t>(acc);
+    std::memcpy(out, &word, sizeof(word));
+    out += sizeof(word);
+    acc >>= 32;
+    filled -= 32;
+  }
+  std::memcpy(out, &acc, filled / 8);
+  for (; idx < count; ++idx)
+    store_packed<Bits>(data, bytes, first + idx, in[idx]);
+}
+}  // namespace detail
+
+// Reference to packed sample, reads and writes only its bits
+template <unsigned Bits>
+class PackedRef {
+ public:
+  using value_type = detail::packed_t<Bits>;
+
+  PackedRef(uint8_t* data, uint64_t bytes, uint64_t sample)
+      : _data(data), _bytes(bytes), _sample(sample) {}
+
+  PackedRef(const PackedRef&) = default;
+
+  operator value_type() const {
+    return detail::load_packed<Bits>(_data, _bytes, _sample);
+  }
+
+  const PackedRef& operator=(value_type value) const {
+    detail::store_packed<Bits>(_data, _bytes, _sample, value);
+    return *this;
+  }
+
+  const PackedRef& operator=(const PackedRef& other) const {
+    return *this = static_cast<value_type>(other);
+  }
+
+ private:
+  uint8_t* _data;
+  uint64_t _bytes;
+  uint64_t _sample;
+};
+
+// Unsigned integers of Bits bits (e.g. 10 or 12 bit detector samples) packed
+// one after another, the first one starting at the lowest bit of the first
+// byte. Ranges, steps and masks select samples as in View, Byte is const for
+// read-only buffers. Bulk operations work on blocks of unpacked values and
+// are much faster than iterators, which locate every element on their own
+template <unsigned Bits, typename Byte = uint8_t>
+class PackedView {
+  static_assert(Bits >= 1 && Bits <= 32, "Samples have 1 to 32 bits");
+  static_assert(std::is_same_v<std::remove_const_t<Byte>, uint8_t>,
+                "Packed buffer consists of uint8_t");
+  static_assert(std::endian::native == std::endian::little,
+                "Packed samples are read as little endian words");
+
+ public:
+  using size_type = std::size_t;
+  using value_type = detail::packed_t<Bits>;
+  using reference = std::conditional_t<std::is_const_v<Byte>, value_type,
+                                       PackedRef<Bits>>;
+  using const_reference = value_type;
+
+  class iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = detail::packed_t<Bits>;
+    using difference_type = std::ptrdiff_t;
+    using reference = PackedView::reference;
+    using pointer = void;
+
+    iterator() = default;
+    iterator(const PackedView* view, uint64_t idx)
+        : _view(view), _idx(idx) {}
+
+    reference operator*() const { return (*_view)[_idx]; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator& operator++() { return *this += 1; }
+    iterator& operator--() { return *this -= 1; }
+    iterator operator++(int) { return std::exchange(*this, *this + 1); }
+    iterator operator--(int) { return std::exchange(*this, *this - 1); }
+
+    iterator& operator+=(difference_type n) {
+      _idx = static_cast<uint64_t>(static_cast<difference_type>(_idx) + n);
+      return *this;
+    }
+    iterator& operator-=(difference_type n) { return *this += -n; }
+    iterator operator+(difference_type n) const { return iterator(*this) += n; }
+    iterator operator-(difference_type n) const { return iterator(*this) -= n; }
+    friend iterator operator+(difference_type n, const iterator& it) {
+      return it + n;
+    }
+    difference_type operator-(const iterator& other) const {
+      return static_cast<difference_type>(_idx) -
+             static_cast<difference_type>(other._idx);
+    }
+
+    bool operator==(const iterator& other) const { return _idx == other._idx; }
+    auto operator<=>(const iterator& other) const {
+      return _idx <=> other._idx;
+    }
+
+   private:
+    const PackedView* _view = nullptr;
+    uint64_t _idx = 0;
+  };
+  using const_iterator = iterator;
+
+  // count samples packed from the beginning of data
+  PackedView(
+      Byte* data, uint64_t count, int64_t step = 1,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : PackedView(data, count, 0, count, step, resource) {}
+
+  PackedView(const PackedView&) = default;
+  PackedView(PackedView&&) noexcept = default;
+
+  constexpr static unsigned bits() { return Bits; }
+
+  uint64_t size() const { return _size; }
+
+  int64_t step() const { return _step; }
+
+  std::pmr::memory_resource* resource() const { return _resource; }
+
+  bool masked() const { return _step == MASK; }
+
+  // Adjacent samples in ascending order
+  bool contiguous() const { return _step == STEP; }
+
+  // Beginning of the packed buffer
+  Byte* data() const { return _data; }
+
+  // Buffer index of the lowest covered sample, positions of masks and ranges
+  // are relative to it
+  uint64_t origin() const { return _origin; }
+
+  // Number of covered samples, entries of mask for masked views
+  uint64_t extent() const { return _span; }
+
+  const MaskInfo& mask() const { return _info; }
+
+  // Buffer index of sample viewed at idx
+  uint64_t sample(uint64_t idx) const {
+    if (_step == MASK) return _origin + _info.select(idx);
+    if (_step > 0) return _origin + idx * static_cast<uint64_t>(_step);
+    return _origin + _span - (idx + 1) * static_cast<uint64_t>(-_step);
+  }
+
+  reference operator[](uint64_t idx) const {
+    if constexpr (std::is_const_v<Byte>)
+      return detail::load_packed<Bits>(_data, bytes(), sample(idx));
+    else
+      return PackedRef<Bits>(_data, bytes(), sample(idx));
+  }
+
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, _size); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  PackedView operator()(Range rng) const {
+    auto extent = static_cast<RangeT>(std::min(_span, _count - _origin));
+    auto stop = std::min(rng._stop, extent);
+    auto start = std::min(rng._start, stop);
+    return PackedView(_data, _count, _origin + static_cast<uint64_t>(start),
+                      static_cast<uint64_t>(stop - start), rng._step,
+                      _resource);
+  }
+
+  PackedView operator()(std::span<const MaskT> mask) const {
+    return (*this)(Mask(mask.begin(), mask.end(), _resource));
+  }
+
+  PackedView operator()(Mask&& mask) const {
+    PackedView view(_data, _count, _origin, 0, STEP, _resource);
+    if (std::min(_span, _count - _origin) < mask.size()) return view;
+    auto resource = mask.get_allocator().resource();
+    view._entries = std::allocate_shared<Mask>(
+        std::pmr::polymorphic_allocator<Mask>(resource), std::move(mask));
+    view._info = MaskInfo(*view._entries, resource);
+    view._step = MASK;
+    view._span = view._entries->size();
+    view._size = view._info.count();
+    return view;
+  }
+
+  // Visit buffer indices of samples in view order
+  template <typename Func>
+  void for_each_sample(Func&& func) const {
+    if (_step == MASK) {
+      for (auto entry = _info.begin; entry != _info.end; ++entry)
+        if (*entry == MASK_TRUE)
+          func(_origin + static_cast<uint64_t>(entry - _info.begin));
+      return;
+    }
+    auto current = static_cast<int64_t>(sample(0));
+    for (uint64_t idx = 0; idx < _size; ++idx, current += _step)
+      func(static_cast<uint64_t>(current));
+  }
+
+  // Call func(values, count) for consecutive blocks of values in view order
+  template <typename Func>
+  void for_blocks(Func&& func) const {
+    std::array<value_type, PACKED_BLOCK> block;
+    if (contiguous()) {
+      for (uint64_t first = 0; first < _size; first += PACKED_BLOCK) {
+        auto count = std::min(PACKED_BLOCK, _size - first);
+        detail::unpack_dense<Bits>(_data, bytes(), _origin + first, count,
+                                   block.data());
+        func(static_cast<const value_type*>(block.data()), count);
+      }
+      return;
+    }
+    uint64_t filled = 0;
+    for_each_sample([&](uint64_t sample) {
+      block[filled] = detail::load_packed<Bits>(_data, bytes(), sample);
+      if (++filled < PACKED_BLOCK) return;
+      func(static_cast<const value_type*>(block.data()), filled);
+      filled = 0;
+    });
+    if (filled != 0) func(static_cast<const value_type*>(block.data()), filled);
+  }
+
+  template <typename Func>
+  void for_each(Func&& func) const {
+    for_blocks([&func](const value_type* values, uint64_t count) {
+      for (uint64_t idx = 0; idx < count; ++idx) func(values[idx]);
+    });
+  }
+
+  template <typename Acc, typename Op = std::plus<>>
+  Acc reduce(Acc init, Op op = {}) const {
+    for_blocks([&init, &op](const value_type* values, uint64_t count) {
+      for (uint64_t idx = 0; idx < count; ++idx) init = op(init, values[idx]);
+    });
+    return init;
+  }
+
+  // Mask of elements for which comp(element, value) holds
+  template <typename Compare>
+  Mask compare(value_type value, Compare comp) const {
+    Mask mask(_size, _resource);
+    auto out = mask.data();
+    for_blocks([&](const value_type* values, uint64_t count) {
+      for (uint64_t idx = 0; idx < count; ++idx)
+        out[idx] = comp(values[idx], value) ? MASK_TRUE : MASK_FALSE;
+      out += count;
+    });
+    return mask;
+  }
+
+  friend Mask operator<(const PackedView& view, value_type value) {
+    return view.compare(value, std::less<>());
+  }
+
+  friend Mask operator>(const PackedView& view, value_type value) {
+    return view.compare(value, std::greater<>());
+  }
+
+  // Copy values in view order into out, nothing is done when sizes differ
+  template <typename U>
+  void unpack(const View<U>& out) const {
+    if (out.size() != _size || _size == 0) return;
+    if constexpr (std::is_same_v<U, value_type>)
+      if (contiguous() && out.contiguous()) {
+        detail::unpack_dense<Bits>(_data, bytes(), _origin, _size, out.data());
+        return;
+      }
+    auto target = out.begin();
+    for_blocks([&target](const value_type* values, uint64_t count) {
+      for (uint64_t idx = 0; idx < count; ++idx, ++target)
+        *target = static_cast<U>(values[idx]);
+    });
+  }
+
+  // Store low Bits bits of values of in, nothing is done when sizes differ
+  template <typename U>
+  void pack(const View<U>& in) const {
+    if (in.size() != _size || _size == 0) return;
+    if constexpr (std::is_same_v<std::remove_const_t<U>, value_type>)
+      if (contiguous() && in.contiguous()) {
+        detail::pack_dense<Bits>(_data, bytes(), _origin, _size, in.data());
+        return;
+      }
+    if (!contiguous()) {
+      auto source = in.begin();
+      for_each_sample([&](uint64_t sample) {
+        detail::store_packed<Bits>(_data, bytes(), sample,
+                                   static_cast<uint64_t>(*source++));
+      });
+      return;
+    }
+    std::array<value_type, PACKED_BLOCK> block;
+    uint64_t filled = 0;
+    auto first = _origin;
+    auto flush = [&] {
+      detail::pack_dense<Bits>(_data, bytes(), first, filled, block.data());
+      first += filled;
+      filled = 0;
+    };
+    in.for_each([&](const U& value) {
+      block[filled] = static_cast<value_type>(value);
+      if (++filled == PACKED_BLOCK) flush();
+    });
+    if (filled != 0) flush();
+  }
+
+  const value_type& operator=(const value_type& value) {
+    std::array<value_type, PACKED_BLOCK> block;
+    block.fill(value);
+    if (!contiguous()) {
+      for_each_sample([&](uint64_t sample) {
+        detail::store_packed<Bits>(_data, bytes(), sample, value);
+      });
+      return value;
+    }
+    for (uint64_t first = 0; first < _size; first += PACKED_BLOCK)
+      detail::pack_dense<Bits>(_data, bytes(), _origin + first,
+                               std::min(PACKED_BLOCK, _size - first),
+                               block.data());
+    return value;
+  }
+
+  // Values are staged in a scratch buffer, so views may overlap
+  const PackedView& operator=(const PackedView& value) {
+    if (value.size() != _size || _size == 0) return value;
+    auto buffer = scratch<value_type>(_size);
+    value.unpack(View<value_type>(buffer.data(), _size));
+    pack(View<const value_type>(buffer.data(), _size));
+    return value;
+  }
+
+ private:
+  PackedView(Byte* data, uint64_t count, uint64_t origin, uint64_t samples,
+             int64_t step, std::pmr::memory_resource* resource)
+      : _data(data),
+        _count(count),
+        _origin(origin),
+        _step(View<Byte>::validate_step(step)),
+        _size(View<Byte>::elements(samples, step)),
+        _resource(resource) {
+    _span = _size * static_cast<uint64_t>(std::abs(_step));
+  }
+
+  uint64_t bytes() const { return detail::packed_bytes<Bits>(_count); }
+
+  Byte* _data = nullptr;
+  // Samples in the whole buffer
+  uint64_t _count = 0;
+  uint64_t _origin = 0;
+  uint64_t _span = 0;
+  int64_t _step = 1;
+  uint64_t _size = 0;
+  std::pmr::memory_resource* _resource;
+  MaskInfo _info;
+  std::shared_ptr<const Mask> _entries;
+};
+}  // namespace SeqView
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace SeqView {
+// Thread configuration of algorithms which can split their work
+struct Threads {
+  uint64_t count = 1;
+  // Smallest amount of work worth a separate thread
+  uint64_t grain = uint64_t(1) << 16;
+
+  static Threads hardware() {
+    return {std::max(1U, std::thread::hardware_concurrency())};
+  }
+
+  uint64_t workers(uint64_t size) const {
+    auto max_workers = std::max<uint64_t>(count, 1);
+    return std::clamp<uint64_t>(size / std::max<uint64_t>(grain, 1), 1,
+                                max_workers);
+  }
+};
+
+// First item of chunk idx when size items are split into almost equal chunks
+constexpr uint64_t chunk_begin(uint64_t size, uint64_t chunks, uint64_t idx) {
+  return size / chunks * idx + std::min(idx, size % chunks);
+}
+
+// Call func(chunk, first, last) for every chunk of size items, each on its
+// own thread, the last chunk is processed by the calling thread
+template <typename Func>
+void parallel_for(uint64_t size, uint64_t chunks, Func&& func) {
+  chunks = std::max<uint64_t>(chunks, 1);
+  std::vector<std::jthread> threads;
+  threads.reserve(chunks - 1);
+  for (uint64_t chunk = 0; chunk + 1 < chunks; ++chunk)
+    threads.emplace_back(func, chunk, chunk_begin(size, chunks, chunk),
+                         chunk_begin(size, chunks, chunk + 1));
+  func(chunks - 1, chunk_begin(size, chunks, chunks - 1), size);
+}
+}  // namespace SeqView
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <sequence_view/view.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SeqView {
+// Chunks are sized to stay in L2 cache while all stages work on them
+constexpr uint64_t CHUNK_BYTES = uint64_t(256) << 10;
+
+template <typename T>
+constexpr uint64_t chunk_elements() {
+  return std::max<uint64_t>(CHUNK_BYTES / sizeof(T), 1);
+}
+
+// Lazy sequence produced by a coroutine, yielded value is valid until the
+// generator is resumed again
+template <typename T>
+class Generator {
+ public:
+  struct promise_type {
+    std::optional<T> current;
+
+    Generator get_return_object() {
+      return Generator(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(T value) {
+      // Views assign elements, value has to be constructed in place
+      current.emplace(std::move(value));
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception() { throw; }
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  class iterator {
+   public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    explicit iterator(Handle handle) : _handle(handle) {}
+
+    iterator& operator++() {
+      _handle.resume();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    T& operator*() const { return *_handle.promise().current; }
+    bool operator==(std::default_sentinel_t) const {
+      return !_handle || _handle.done();
+    }
+
+   private:
+    Handle _handle;
+  };
+
+  Generator(Generator&& other) noexcept
+      : _handle(std::exchange(other._handle, {})) {}
+  Generator(const Generator&) = delete;
+  Generator& operator=(const Generator&) = delete;
+  ~Generator() {
+    if (_handle) _handle.destroy();
+  }
+
+  iterator begin() {
+    _handle.resume();
+    return iterator(_handle);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  explicit Generator(Handle handle) : _handle(handle) {}
+
+  Handle _handle;
+};
+
+// Consecutive subviews of at most elements items covering the whole view
+template <typename T>
+Generator<View<T>> chunks(View<T> view,
+                          uint64_t elements = chunk_elements<T>()) {
+  elements = std::max<uint64_t>(elements, 1);
+  for (uint64_t first = 0; first < view.size(); first += elements)
+    co_yield view.subview(first, std::min(view.size(), first + elements));
+}
+
+// Elements of every chunk matching predicate, packed densely into a buffer
+// owned by the stage
+template <typename T, typename Predicate>
+Generator<View<T>> filter(Generator<View<T>> input, Predicate pred) {
+  std::vector<std::remove_const_t<T>> buffer;
+  for (auto& chunk : input) {
+    buffer.resize(chunk.size());
+    uint64_t kept = 0;
+    chunk.for_each([&](const T& elem) {
+      buffer[kept] = elem;
+      kept += pred(elem) ? 1 : 0;
+    });
+    if (kept != 0) co_yield View<T>(buffer.data(), kept);
+  }
+}
+
+// Results of func for every element, written densely into a buffer owned by
+// the stage
+template <typename T, typename Func,
+          typename U = std::decay_t<std::invoke_result_t<Func&, T&>>>
+Generator<View<U>> map(Generator<View<T>> input, Func func) {
+  std::vector<U> buffer;
+  for (auto& chunk : input) {
+    buffer.resize(chunk.size());
+    auto out = buffer.data();
+    chunk.for_each([&](T& elem) { *out++ = func(elem); });
+    co_yield View<U>(buffer.data(), chunk.size());
+  }
+}
+
+template <typename T, typename Acc, typename Op>
+Acc reduce(Generator<View<T>> input, Acc init, Op op) {
+  for (auto& chunk : input)
+    chunk.for_each([&](const T& elem) { init = op(init, elem); });
+  return init;
+}
+
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(uint64_t capacity)
+      : _capacity(std::max<uint64_t>(capacity, 1)) {}
+
+  // Blocks while full, false when queue was closed
+  bool push(T item) {
+    std::unique_lock lock(_mutex);
+    _cond.wait(lock, [&] { return _closed || _items.size() < _capacity; });
+    if (_closed) return false;
+    _items.push_back(std::move(item));
+    _cond.notify_all();
+    return true;
+  }
+
+  // Blocks while empty, nothing when queue was closed and drained
+  std::optional<T> pop() {
+    std::unique_lock lock(_mutex);
+    _cond.wait(lock, [&] { return _closed || !_items.empty(); });
+    if (_items.empty()) return std::nullopt;
+    auto item = std::move(_items.front());
+    _items.pop_front();
+    _cond.notify_all();
+    return item;
+  }
+
+  void close() {
+    std::lock_guard lock(_mutex);
+    _closed = true;
+    _cond.notify_all();
+  }
+
+ private:
+  std::mutex _mutex;
+  std::condition_variable _cond;
+  std::deque<T> _items;
+  uint64_t _capacity;
+  bool _closed = false;
+};
+
+// Runs input stages on a separate thread, up to depth chunks are copied into
+// recycled buffers and handed over through bounded queue
+template <typename T>
+Generator<View<T>> threaded(Generator<View<T>> input, uint64_t depth = 2) {
+  using Buffer = std::vector<std::remove_const_t<T>>;
+  BoundedQueue<Buffer> ready(depth);
+  BoundedQueue<Buffer> spare(depth);
+  for (uint64_t idx = 0; idx < std::max<uint64_t>(depth, 1); ++idx)
+    spare.push(Buffer());
+
+  std::jthread producer([&] {
+    for (auto& chunk : input) {
+      auto buffer = spare.pop();
+      if (!buffer) return;
+      buffer->resize(chunk.size());
+      chunk.gather(buffer->data());
+      if (!ready.push(std::move(*buffer))) return;
+    }
+    ready.close();
+  });
+  // Destroyed before producer is joined, also when consumer stops early
+  struct Closer {
+    BoundedQueue<Buffer>& ready;
+    BoundedQueue<Buffer>& spare;
+    ~Closer() {
+      ready.close();
+      spare.close();
+    }
+  } closer{ready, spare};
+
+  while (auto buffer = ready.pop()) {
+    co_yield View<T>(buffer->data(), buffer->size());
+    spare.push(std::move(*buffer));
+  }
+}
+}  // namespace SeqView
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <sequence_view/scan.hpp>
+#include <sequence_view/scratch.hpp>
+#include <sequence_view/view.hpp>
+#include <type_traits>
+
+namespace SeqView {
+namespace detail {
+// Window sums of dense input, differences of elements entering and leaving
+// the window are computed independently and then scanned from the first sum
+template <typename T, typename U>
+void rolling_sum(const T* in, U* out, uint64_t windows, uint64_t window) {
+  U first{};
+  for (uint64_t idx = 0; idx < window; ++idx) first += in[idx];
+  out[0] = first;
+  for (uint64_t idx = 1; idx < windows; ++idx)
+    out[idx] =
+        static_cast<U>(in[idx + window - 1]) - static_cast<U>(in[idx - 1]);
+  std::plus<> op;
+  scan_dense(out + 1, out + 1, windows - 1, first, op, false);
+}
+
+// Monotonic deque of positions, front is the extreme of the current window
+// and every position enters and leaves it once
+template <typename T, typename U, typename Compare>
+void rolling_extreme(const T* in, U* out, uint64_t windows, uint64_t window,
+                     Compare comp) {
+  auto queue = scratch<uint64_t, 2>(windows + window - 1).data();
+  uint64_t head = 0;
+  uint64_t tail = 0;
+  for (uint64_t idx = 0; idx < windows + window - 1; ++idx) {
+    while (tail != head && !comp(in[queue[tail - 1]], in[idx])) --tail;
+    queue[tail++] = idx;
+    if (idx + 1 < window) continue;
+    auto start = idx + 1 - window;
+    if (queue[head] < start) ++head;
+    out[start] = in[queue[head]];
+  }
+}
+
+// Welford update for element entering and another leaving the window, mean
+// and sum of squared differences from it are carried between windows
+template <typename T, typename U>
+void rolling_variance(const T* in, U* out, uint64_t windows, uint64_t window,
+                      uint64_t ddof, bool root) {
+  auto size = static_cast<double>(window);
+  auto divisor = static_cast<double>(window - std::min(ddof, window - 1));
+  double mean = 0.0;
+  double squares = 0.0;
+  for (uint64_t idx = 0; idx < window; ++idx) {
+    auto value = static_cast<double>(in[idx]);
+    auto delta = value - mean;
+    mean += delta / static_cast<double>(idx + 1);
+    squares += delta * (value - mean);
+  }
+  for (uint64_t idx = 0;; ++idx) {
+    auto variance = std::max(squares, 0.0) / divisor;
+    out[idx] = static_cast<U>(root ? std::sqrt(variance) : variance);
+    if (idx + 1 == windows) return;
+    auto entering = static_cast<double>(in[idx + window]);
+    auto leaving = static_cast<double>(in[idx]);
+    auto previous = mean;
+    mean += (entering - leaving) / size;
+    squares += (entering - leaving) * (entering - mean + leaving - previous);
+  }
+}
+}  // namespace detail
+
+// Windows of consecutive elements of a view, aggregates of all windows are
+// computed incrementally in a single pass and written into a view of size()
+// elements, nothing is done when sizes differ
+template <typename T>
+class Rolling {
+ public:
+  Rolling(const View<T>& view, uint64_t window)
+      : _view(view), _window(window) {}
+
+  uint64_t window() const { return _window; }
+
+  // Number of windows
+  uint64_t size() const {
+    if (_window == 0 || _view.size() < _window) return 0;
+    return _view.size() - _window + 1;
+  }
+
+  View<T> operator[](uint64_t idx) const {
+    return _view.subview(idx, idx + _window);
+  }
+
+  template <typename U>
+  void sum(const View<U>& out) const {
+    run(out, [this](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_sum(in, dst, windows, _window);
+    });
+  }
+
+  template <typename U>
+  void mean(const View<U>& out) const {
+    run(out, [this](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_sum(in, dst, windows, _window);
+      for (uint64_t idx = 0; idx < windows; ++idx)
+        dst[idx] /= static_cast<U>(_window);
+    });
+  }
+
+  template <typename U>
+  void min(const View<U>& out) const {
+    run(out, [this](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_extreme(in, dst, windows, _window, std::less<>());
+    });
+  }
+
+  template <typename U>
+  void max(const View<U>& out) const {
+    run(out, [this](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_extreme(in, dst, windows, _window, std::greater<>());
+    });
+  }
+
+  // Sum of squared differences from the mean divided by window - ddof
+  template <typename U>
+  void variance(const View<U>& out, uint64_t ddof = 0) const {
+    run(out, [this, ddof](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_variance(in, dst, windows, _window, ddof, false);
+    });
+  }
+
+  template <typename U>
+  void stddev(const View<U>& out, uint64_t ddof = 0) const {
+    run(out, [this, ddof](const auto* in, U* dst, uint64_t windows) {
+      detail::rolling_variance(in, dst, windows, _window, ddof, true);
+    });
+  }
+
+ private:
+  // Kernels work on dense memory, views which are not contiguous are
+  // gathered into and scattered from scratch buffers
+  template <typename U, typename Kernel>
+  void run(const View<U>& out, Kernel kernel) const {
+    auto windows = size();
+    if (windows == 0 || out.size() != windows) return;
+    const T* in = _view.data();
+    if (!_view.contiguous()) {
+      auto buffer = scratch<std::remove_const_t<T>>(_view.size());
+      _view.gather(buffer.data());
+      in = buffer.data();
+    }
+    if (out.contiguous()) {
+      kernel(in, out.data(), windows);
+      return;
+    }
+    auto buffer = scratch<U, 1>(windows);
+    kernel(in, buffer.data(), windows);
+    out.scatter(buffer.data());
+  }
+
+  View<T> _view;
+  uint64_t _window;
+};
+
+template <typename T>
+Rolling<T> rolling(const View<T>& view, uint64_t window) {
+  return Rolling<T>(view, window);
+}
+}  // namespace SeqView
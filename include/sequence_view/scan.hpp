@@ -0,0 +1,212 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <sequence_view/parallel.hpp>
+#include <sequence_view/view.hpp>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace SeqView {
+namespace detail {
+#if defined(__SSE2__)
+template <typename T>
+struct SseScan;
+
+template <>
+struct SseScan<int32_t> {
+  using Reg = __m128i;
+  static Reg load(const int32_t* ptr) {
+    return _mm_loadu_si128(reinterpret_cast<const Reg*>(ptr));
+  }
+  static void store(int32_t* ptr, Reg reg) {
+    _mm_storeu_si128(reinterpret_cast<Reg*>(ptr), reg);
+  }
+  static Reg set1(int32_t value) { return _mm_set1_epi32(value); }
+  static Reg add(Reg lhs, Reg rhs) { return _mm_add_epi32(lhs, rhs); }
+  template <int Bytes>
+  static Reg shift(Reg reg) {
+    return _mm_slli_si128(reg, Bytes);
+  }
+  static Reg last(Reg reg) { return _mm_shuffle_epi32(reg, 0xFF); }
+  static int32_t first(Reg reg) { return _mm_cvtsi128_si32(reg); }
+};
+
+template <>
+struct SseScan<uint32_t> : SseScan<int32_t> {
+  static Reg load(const uint32_t* ptr) {
+    return _mm_loadu_si128(reinterpret_cast<const Reg*>(ptr));
+  }
+  static void store(uint32_t* ptr, Reg reg) {
+    _mm_storeu_si128(reinterpret_cast<Reg*>(ptr), reg);
+  }
+  static Reg set1(uint32_t value) {
+    return _mm_set1_epi32(static_cast<int32_t>(value));
+  }
+  static uint32_t first(Reg reg) {
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(reg));
+  }
+};
+
+template <>
+struct SseScan<float> {
+  using Reg = __m128;
+  static Reg load(const float* ptr) { return _mm_loadu_ps(ptr); }
+  static void store(float* ptr, Reg reg) { _mm_storeu_ps(ptr, reg); }
+  static Reg set1(float value) { return _mm_set1_ps(value); }
+  static Reg add(Reg lhs, Reg rhs) { return _mm_add_ps(lhs, rhs); }
+  template <int Bytes>
+  static Reg shift(Reg reg) {
+    return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(reg), Bytes));
+  }
+  static Reg last(Reg reg) { return _mm_shuffle_ps(reg, reg, 0xFF); }
+  static float first(Reg reg) { return _mm_cvtss_f32(reg); }
+};
+
+template <typename T, typename U, typename Op>
+constexpr bool sse_scannable =
+    std::is_same_v<T, U> &&
+    (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>) &&
+    (std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> ||
+     std::is_same_v<T, float>);
+
+// Sum of 4 lanes is scanned in register with two shifted adds, carry of the
+// previous block is broadcasted and added to every lane
+template <typename T>
+T sse_scan(const T* in, T* out, uint64_t size, T acc, bool exclusive) {
+  using Sse = SseScan<T>;
+  auto carry = Sse::set1(acc);
+  uint64_t idx = 0;
+  for (; idx + 4 <= size; idx += 4) {
+    auto sums = Sse::load(in + idx);
+    sums = Sse::add(sums, Sse::template shift<4>(sums));
+    sums = Sse::add(sums, Sse::template shift<8>(sums));
+    auto result = exclusive ? Sse::template shift<4>(sums) : sums;
+    Sse::store(out + idx, Sse::add(result, carry));
+    carry = Sse::add(carry, Sse::last(sums));
+  }
+  acc = Sse::first(carry);
+  for (; idx < size; ++idx) {
+    auto value = in[idx];
+    out[idx] = exclusive ? acc : acc + value;
+    acc += value;
+  }
+  return acc;
+}
+#endif
+
+// Scan of dense data continuing from acc, works in place, returns reduction
+// of acc and all elements
+template <typename T, typename U, typename Op>
+U scan_dense(const T* in, U* out, uint64_t size, U acc, Op& op,
+             bool exclusive) {
+#if defined(__SSE2__)
+  if constexpr (sse_scannable<T, U, Op>)
+    return sse_scan(in, out, size, acc, exclusive);
+#endif
+  for (uint64_t idx = 0; idx < size; ++idx) {
+    U value = in[idx];
+    auto next = op(acc, value);
+    out[idx] = exclusive ? acc : next;
+    acc = next;
+  }
+  return acc;
+}
+
+// Scan elements [first, last) of src into dst, acc is reduction of elements
+// before first, empty for start of inclusive scan
+template <typename T, typename U, typename Op>
+std::optional<U> scan_chunk(const View<T>& src, const View<U>& dst,
+                            uint64_t first, uint64_t last, std::optional<U> acc,
+                            Op& op, bool exclusive) {
+  if (first == last) return acc;
+  if (src.contiguous() && dst.contiguous()) {
+    auto in = src.data() + first;
+    auto out = dst.data() + first;
+    if (!acc) {
+      acc = *out++ = *in++;
+      ++first;
+    }
+    return scan_dense(in, out, last - first, *acc, op, exclusive);
+  }
+  auto in = src.begin() + static_cast<int64_t>(first);
+  auto out = dst.begin() + static_cast<int64_t>(first);
+  for (auto idx = first; idx < last; ++idx, ++in, ++out) {
+    U value = *in;
+    auto next = acc ? op(*acc, value) : value;
+    *out = exclusive ? *acc : next;
+    acc = next;
+  }
+  return acc;
+}
+
+template <typename T, typename U, typename Op>
+std::optional<U> reduce_chunk(const View<T>& src, uint64_t first,
+                              uint64_t last, Op& op) {
+  if (first == last) return std::nullopt;
+  if (src.contiguous()) {
+    auto in = src.data();
+    U acc = in[first];
+    for (auto idx = first + 1; idx < last; ++idx) acc = op(acc, in[idx]);
+    return acc;
+  }
+  auto in = src.begin() + static_cast<int64_t>(first);
+  U acc = *in++;
+  for (auto idx = first + 1; idx < last; ++idx, ++in) acc = op(acc, *in);
+  return acc;
+}
+
+// Large inputs are scanned in two passes, chunks are reduced in parallel,
+// their totals scanned serially and then chunks are scanned in parallel
+// starting from total of preceding ones
+template <typename T, typename U, typename Op>
+void scan(const View<T>& src, const View<U>& dst, std::optional<U> init,
+          Op& op, Threads threads, bool exclusive) {
+  auto size = src.size();
+  if (size != dst.size()) return;
+  auto workers = threads.workers(size);
+  if (workers == 1) {
+    scan_chunk(src, dst, 0, size, init, op, exclusive);
+    return;
+  }
+
+  std::vector<std::optional<U>> offsets(workers);
+  parallel_for(size, workers,
+               [&](uint64_t worker, uint64_t first, uint64_t last) {
+                 if (worker + 1 == workers) return;
+                 offsets[worker + 1] =
+                     reduce_chunk<T, U>(src, first, last, op);
+               });
+  offsets[0] = init;
+  for (uint64_t worker = 1; worker < workers; ++worker)
+    if (offsets[worker - 1])
+      offsets[worker] = op(*offsets[worker - 1], *offsets[worker]);
+  parallel_for(size, workers,
+               [&](uint64_t worker, uint64_t first, uint64_t last) {
+                 scan_chunk(src, dst, first, last, offsets[worker], op,
+                            exclusive);
+               });
+}
+}  // namespace detail
+
+// dst[i] = src[0] op ... op src[i], views have to be of equal size, dst may
+// be the same view as src
+template <typename T, typename U, typename Op = std::plus<>>
+void inclusive_scan(const View<T>& src, const View<U>& dst, Op op = {},
+                    Threads threads = {}) {
+  detail::scan(src, dst, std::optional<U>(), op, threads, false);
+}
+
+// dst[i] = init op src[0] op ... op src[i - 1]
+template <typename T, typename U, typename Op = std::plus<>>
+void exclusive_scan(const View<T>& src, const View<U>& dst,
+                    std::type_identity_t<U> init, Op op = {},
+                    Threads threads = {}) {
+  detail::scan(src, dst, std::optional<U>(init), op, threads, true);
+}
+}  // namespace SeqView
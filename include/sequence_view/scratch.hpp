@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace SeqView {
+// Per-thread buffer reused between algorithm calls, so gathering elements of
+// a view does not allocate every time. Different slots can be used at once.
+template <typename T, int Slot = 0>
+std::span<T> scratch(uint64_t size) {
+  thread_local std::vector<T> buffer;
+  if (buffer.size() < size) buffer.resize(size);
+  return {buffer.data(), size};
+}
+}  // namespace SeqView
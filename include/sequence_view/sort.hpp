@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <sequence_view/scratch.hpp>
+#include <sequence_view/view.hpp>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace SeqView {
+namespace detail {
+// Below that size comparison sort wins over radix passes
+constexpr uint64_t RADIX_THRESHOLD = 256;
+
+template <typename T, typename Compare>
+constexpr bool radix_sortable =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    (std::is_same_v<Compare, std::less<>> ||
+     std::is_same_v<Compare, std::less<T>>);
+
+template <typename T>
+auto radix_key(T value) {
+  using Key = std::make_unsigned_t<T>;
+  constexpr Key sign_flip =
+      std::is_signed_v<T> ? Key(1) << (sizeof(T) * 8 - 1) : Key(0);
+  return static_cast<Key>(static_cast<Key>(value) ^ sign_flip);
+}
+
+// Stable LSD radix sort with 8 bit digits, tmp has to be as large as data
+template <typename T>
+void radix_sort(std::span<T> data, std::span<T> tmp) {
+  constexpr uint64_t digits = sizeof(T);
+  std::array<std::array<uint64_t, 256>, digits> counts{};
+  for (const auto& elem : data) {
+    auto key = radix_key(elem);
+    for (uint64_t digit = 0; digit < digits; ++digit)
+      ++counts[digit][(key >> (digit * 8)) & 0xFF];
+  }
+
+  auto src = data.data();
+  auto dst = tmp.data();
+  for (uint64_t digit = 0; digit < digits; ++digit) {
+    auto& count = counts[digit];
+    // All keys share that digit, pass would not change the order
+    if (std::find(count.begin(), count.end(), data.size()) != count.end())
+      continue;
+    uint64_t offset = 0;
+    for (auto& bucket : count) offset += std::exchange(bucket, offset);
+    for (uint64_t idx = 0; idx < data.size(); ++idx) {
+      auto bucket = (radix_key(src[idx]) >> (digit * 8)) & 0xFF;
+      dst[count[bucket]++] = src[idx];
+    }
+    std::swap(src, dst);
+  }
+  if (src != data.data()) std::copy(src, src + data.size(), data.data());
+}
+
+template <typename T, typename Compare>
+void dense_sort(std::span<T> data, Compare comp, bool stable) {
+  if constexpr (radix_sortable<T, Compare>) {
+    if (data.size() >= RADIX_THRESHOLD) {
+      radix_sort(data, scratch<T, 1>(data.size()));
+      return;
+    }
+  }
+  if (stable)
+    std::stable_sort(data.begin(), data.end(), comp);
+  else
+    std::sort(data.begin(), data.end(), comp);
+}
+
+// Run algorithm on dense elements, directly for contiguous views, otherwise
+// through gather into scratch buffer and scatter back
+template <typename T, typename Algo>
+void on_dense(const View<T>& view, Algo&& algo) {
+  if (view.contiguous()) {
+    algo(std::span<T>(view.data(), view.size()));
+    return;
+  }
+  auto buffer = scratch<T>(view.size());
+  view.gather(buffer.data());
+  algo(buffer);
+  view.scatter(buffer.data());
+}
+}  // namespace detail
+
+template <typename T, typename Compare = std::less<>>
+void sort(const View<T>& view, Compare comp = {}) {
+  detail::on_dense(view, [&](std::span<T> data) {
+    detail::dense_sort(data, comp, false);
+  });
+}
+
+template <typename T, typename Compare = std::less<>>
+void stable_sort(const View<T>& view, Compare comp = {}) {
+  detail::on_dense(view, [&](std::span<T> data) {
+    detail::dense_sort(data, comp, true);
+  });
+}
+
+// Element at nth position is the one that would be there after sort, smaller
+// ones are before it, larger after
+template <typename T, typename Compare = std::less<>>
+void nth_element(const View<T>& view, uint64_t nth, Compare comp = {}) {
+  if (nth >= view.size()) return;
+  detail::on_dense(view, [&](std::span<T> data) {
+    std::nth_element(data.begin(), data.begin() + static_cast<int64_t>(nth),
+                     data.end(), comp);
+  });
+}
+
+// Move elements matching predicate in front of the others keeping relative
+// order of both groups, returns number of matching elements
+template <typename T, typename Predicate>
+uint64_t partition(const View<T>& view, Predicate pred) {
+  auto size = view.size();
+  auto buffer = scratch<T>(size);
+  uint64_t front = 0;
+  uint64_t back = size;
+  view.for_each([&](const T& elem) {
+    if (pred(elem))
+      buffer[front++] = elem;
+    else
+      buffer[--back] = elem;
+  });
+  std::reverse(buffer.begin() + static_cast<int64_t>(front), buffer.end());
+  view.scatter(buffer.data());
+  return front;
+}
+}  // namespace SeqView
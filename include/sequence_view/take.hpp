@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/scratch.hpp>
+#include <sequence_view/view.hpp>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace SeqView {
+namespace detail {
+// Indices are translated to addresses for a whole batch before any access
+constexpr uint64_t TAKE_BATCH = 256;
+// Accesses issued ahead of the one being done
+constexpr uint64_t PREFETCH_DISTANCE = 16;
+
+template <typename T>
+void prefetch_read(const T* ptr) {
+#if defined(__GNUC__)
+  __builtin_prefetch(ptr, 0);
+#endif
+}
+
+template <typename T>
+void prefetch_write(const T* ptr) {
+#if defined(__GNUC__)
+  __builtin_prefetch(ptr, 1);
+#endif
+}
+
+// Byte offsets of view elements from the origin of the view. Large batches of
+// lookups into masked views resolve all valid positions once instead of
+// selecting every one of them
+template <typename T>
+class Addresses {
+ public:
+  Addresses(const View<T>& view, uint64_t lookups)
+      : _size(view.size()), _pitch(view.pitch()) {
+    if (!view.masked()) {
+      _first = bytes_between(view.origin(), view.data());
+      _stride = view.step() * _pitch;
+      return;
+    }
+    _mask = &view.mask();
+    if (lookups * MASK_BLOCK < view.extent()) return;
+    auto table = scratch<uint64_t, 3>(_size);
+    uint64_t valid = 0;
+    for (auto entry = _mask->begin; entry != _mask->end; ++entry)
+      if (*entry == MASK_TRUE)
+        table[valid++] = static_cast<uint64_t>(entry - _mask->begin);
+    _table = table.data();
+  }
+
+  // False for indices outside of the view
+  template <typename I>
+  bool operator()(I idx, int64_t& offset) const {
+    if constexpr (std::is_signed_v<I>)
+      if (idx < 0) return false;
+    auto position = static_cast<uint64_t>(idx);
+    if (position >= _size) return false;
+    if (_mask == nullptr)
+      offset = _first + static_cast<int64_t>(position) * _stride;
+    else if (_table != nullptr)
+      offset = static_cast<int64_t>(_table[position]) * _pitch;
+    else
+      offset = static_cast<int64_t>(_mask->select(position)) * _pitch;
+    return true;
+  }
+
+ private:
+  uint64_t _size;
+  int64_t _pitch;
+  int64_t _first = 0;
+  int64_t _stride = 0;
+  const MaskInfo* _mask = nullptr;
+  const uint64_t* _table = nullptr;
+};
+
+template <typename T>
+constexpr bool gatherable =
+    std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+// Load elements at byte offsets from base, 4 at a time with AVX2 gathers
+template <typename T>
+void load_batch(const T* base, const int64_t* offsets, T* values,
+                uint64_t count) {
+  uint64_t idx = 0;
+#if defined(__AVX2__)
+  if constexpr (gatherable<T>) {
+    auto bytes = reinterpret_cast<const char*>(base);
+    for (; idx + 4 <= count; idx += 4) {
+      auto lanes = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(offsets + idx));
+      if constexpr (sizeof(T) == 4) {
+        auto loaded = _mm256_i64gather_epi32(
+            reinterpret_cast<const int*>(bytes), lanes, 1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(values + idx), loaded);
+      } else {
+        auto loaded = _mm256_i64gather_epi64(
+            reinterpret_cast<const long long*>(bytes), lanes, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + idx), loaded);
+      }
+    }
+  }
+#endif
+  for (; idx < count; ++idx) {
+    if (idx + PREFETCH_DISTANCE < count)
+      prefetch_read(offset_bytes(base, offsets[idx + PREFETCH_DISTANCE]));
+    values[idx] = *offset_bytes(base, offsets[idx]);
+  }
+}
+
+// Store elements at byte offsets from base in order, so later duplicates win,
+// 8 at a time with AVX-512 scatters which keep that order
+template <typename T>
+void store_batch(T* base, const int64_t* offsets, const T* values,
+                 uint64_t count) {
+  uint64_t idx = 0;
+#if defined(__AVX512F__)
+  if constexpr (gatherable<T>) {
+    auto bytes = reinterpret_cast<char*>(base);
+    for (; idx + 8 <= count; idx += 8) {
+      auto lanes = _mm512_loadu_si512(offsets + idx);
+      if constexpr (sizeof(T) == 4) {
+        auto stored = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(values + idx));
+        _mm512_i64scatter_epi32(bytes, lanes, stored, 1);
+      } else {
+        auto stored = _mm512_loadu_si512(values + idx);
+        _mm512_i64scatter_epi64(bytes, lanes, stored, 1);
+      }
+    }
+  }
+#endif
+  for (; idx < count; ++idx) {
+    if (idx + PREFETCH_DISTANCE < count)
+      prefetch_write(offset_bytes(base, offsets[idx + PREFETCH_DISTANCE]));
+    *offset_bytes(base, offsets[idx]) = values[idx];
+  }
+}
+
+// Call flush(offsets, inside, valid, count) for batches of translated indices,
+// valid is false when some index of the batch is outside of the view
+template <typename T, typename I, typename Flush>
+void for_batches(const View<T>& view, const View<I>& indices, Flush flush) {
+  Addresses<T> addresses(view, indices.size());
+  std::array<int64_t, TAKE_BATCH> offsets;
+  std::array<bool, TAKE_BATCH> inside;
+  uint64_t filled = 0;
+  bool valid = true;
+  auto drain = [&] {
+    flush(offsets.data(), inside.data(), valid, filled);
+    filled = 0;
+    valid = true;
+  };
+  indices.for_each([&](const I& idx) {
+    inside[filled] = addresses(idx, offsets[filled]);
+    valid = valid && inside[filled];
+    if (++filled == TAKE_BATCH) drain();
+  });
+  if (filled != 0) drain();
+}
+}  // namespace detail
+
+// out[i] = view[indices[i]], indices are positions of the view, outputs of
+// indices outside of it are left untouched, nothing is done when sizes of
+// indices and out differ
+template <typename T, typename I, typename U>
+void take(const View<T>& view, const View<I>& indices, const View<U>& out) {
+  static_assert(std::is_integral_v<I>, "Indices have to be integral");
+  if (indices.size() != out.size() || indices.size() == 0) return;
+  using Value = std::remove_const_t<T>;
+  std::array<Value, detail::TAKE_BATCH> values;
+  const T* base = view.origin();
+  auto target = out.begin();
+  detail::for_batches(
+      view, indices,
+      [&](const int64_t* offsets, const bool* inside, bool valid,
+          uint64_t count) {
+        if (valid) {
+          detail::load_batch<Value>(base, offsets, values.data(), count);
+          for (uint64_t idx = 0; idx < count; ++idx, ++target)
+            *target = values[idx];
+          return;
+        }
+        for (uint64_t idx = 0; idx < count; ++idx, ++target)
+          if (inside[idx]) *target = *offset_bytes(base, offsets[idx]);
+      });
+}
+
+// view[indices[i]] = values[i] in order of indices, indices outside of the
+// view are skipped, nothing is done when sizes of indices and values differ
+template <typename T, typename I, typename U>
+void put(const View<T>& view, const View<I>& indices, const View<U>& values) {
+  static_assert(std::is_integral_v<I>, "Indices have to be integral");
+  if (indices.size() != values.size() || indices.size() == 0) return;
+  std::array<T, detail::TAKE_BATCH> batch;
+  auto base = view.origin();
+  auto source = values.begin();
+  detail::for_batches(
+      view, indices,
+      [&](const int64_t* offsets, const bool* inside, bool valid,
+          uint64_t count) {
+        if (valid) {
+          for (uint64_t idx = 0; idx < count; ++idx, ++source)
+            batch[idx] = *source;
+          detail::store_batch(base, offsets, batch.data(), count);
+          return;
+        }
+        for (uint64_t idx = 0; idx < count; ++idx, ++source)
+          if (inside[idx]) *offset_bytes(base, offsets[idx]) = *source;
+      });
+}
+}  // namespace SeqView
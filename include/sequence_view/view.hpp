@@ -1,6 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/nd-view.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/scratch.hpp>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace SeqView {
@@ -25,7 +37,8 @@ class View {
 
   constexpr static uint64_t elements(uint64_t size, int64_t step) {
     if (size == 0 || step == 0) return 0;
-    uint64_t step_abs = static_cast<uint64_t>(std::abs(step));
+    // std::abs is not constexpr before C++23
+    auto step_abs = static_cast<uint64_t>(step < 0 ? -step : step);
     if (step_abs > size) return 1;
     return (size - 1) / step_abs + 1;
   }
@@ -33,7 +46,7 @@ class View {
   constexpr static pointer last_ptr(pointer ptr, uint64_t size, int64_t step) {
     auto number_of_jumps = elements(size, step);
     auto first_outside_boundary =
-        number_of_jumps * static_cast<uint64_t>(std::abs(step));
+        number_of_jumps * static_cast<uint64_t>(step < 0 ? -step : step);
     return ptr + first_outside_boundary;
   }
 
@@ -47,51 +60,204 @@ class View {
     return last_ptr(ptr, size, step);
   }
 
-  View(pointer ptr, uint64_t size, int64_t step = 1)
-      : _ptr(base_ptr(ptr, size, step)),
-        _end(end_ptr(ptr, size, step)),
-        _step(validate_step(step)),
-        _size(elements(size, step)) {}
+  View(pointer ptr, uint64_t size, int64_t step = 1,
+       std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : View(ptr, size, step, sizeof(T), resource) {}
 
-  View(pointer ptr, std::vector<uint8_t> mask)
-      : _ptr(ptr),
-        _end(ptr + mask.size()),
-        _step(MASK),
-        _info(mask),
-        _mask(std::move(mask)) {
-    _size = _info.count();
+  // Mask and its index are allocated from the resource of the mask, index of
+  // large masks can be built by multiple threads
+  View(pointer ptr, Mask mask, Threads threads = {})
+      : View(ptr, std::move(mask), sizeof(T), threads) {}
+
+  View(pointer ptr, std::span<const MaskT> mask,
+       std::pmr::memory_resource* resource = std::pmr::get_default_resource(),
+       Threads threads = {})
+      : View(ptr, Mask(mask.begin(), mask.end(), resource), threads) {}
+
+  // Positions selected by an existing mask index (e.g. loaded from a file),
+  // its entries are shared instead of copied
+  static View from_mask(
+      pointer ptr, MaskInfo info,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    View view(ptr, 0, STEP, sizeof(T), resource);
+    info.ptr = info.begin;
+    view._step = MASK;
+    view._end = view.advance(ptr, info.end - info.begin);
+    view._info = std::move(info);
+    view._size = view._info.count();
+    return view;
+  }
+
+  // Member of size records laid out one after another, positions of the view
+  // are records, so ranges, steps and masks apply to records
+  template <typename Record, typename Owner, typename Member>
+  static View field(
+      Record* records, uint64_t size, Member Owner::*member, int64_t step = 1,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    static_assert(std::is_same_v<std::remove_cv_t<Record>, Owner>,
+                  "Member has to belong to the record type");
+    if (size == 0) return View(nullptr, 0, step, sizeof(Record), resource);
+    return View(&(records->*member), size, step, sizeof(Record), resource);
   }
 
+  template <typename Records, typename Owner, typename Member>
+  static View field(
+      Records& records, Member Owner::*member, int64_t step = 1,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    return field(std::data(records), std::size(records), member, step,
+                 resource);
+  }
+
+  View(const View& other)
+      : _ptr(other._ptr),
+        _end(other._end),
+        _step(other._step),
+        _pitch(other._pitch),
+        _size(other._size),
+        _info(other._info),
+        _mask(other._mask, other._mask.get_allocator()) {
+    // Shared entries stay where they are
+    if (_step == MASK && other._info.begin == other._mask.data())
+      _info.rebase(_mask.data());
+  }
+
+  View(View&& other) noexcept = default;
+
   uint64_t size() const { return _step != MASK ? _size : _info.count(); }
 
-  iterator begin() const { return iterator(_ptr, _step, _info); }
+  int64_t step() const { return _step; }
 
-  iterator end() const { return iterator(_end, _step, _info + (_end - _ptr)); }
+  // Resource used for masks created from this view
+  std::pmr::memory_resource* resource() const {
+    return _mask.get_allocator().resource();
+  }
+
+  // Bytes between adjacent positions, size of the record for field views
+  int64_t pitch() const { return _pitch; }
+
+  // Elements are adjacent in memory and visited in ascending address order
+  bool contiguous() const {
+    return _step == STEP && _pitch == static_cast<int64_t>(sizeof(T));
+  }
+
+  // Address of the first element
+  pointer data() const { return element_at(0); }
+
+  // Lowest address of viewed memory, positions of masks are relative to it
+  pointer origin() const { return _step < 0 ? _end : _ptr; }
+
+  const MaskInfo& mask() const { return _info; }
+
+  bool masked() const { return _step == MASK; }
+
+  // Number of positions covered by the view, elements of strided view or
+  // entries of mask, used to split work without resolving the mask
+  uint64_t extent() const {
+    return _step == MASK ? static_cast<uint64_t>(_info.end - _info.begin)
+                         : _size;
+  }
+
+  // Visit elements in view order, faster than iterators for masked views
+  template <typename Func>
+  void for_each(Func&& func) const {
+    for_each(std::forward<Func>(func), 0, extent());
+  }
+
+  // Visit elements at positions [first, last) of the view
+  template <typename Func>
+  void for_each(Func&& func, uint64_t first, uint64_t last) const {
+    if (_step == MASK) {
+      for (auto mask = _info.begin + first; mask != _info.begin + last; ++mask)
+        if (*mask == MASK_TRUE) func(*advance(_ptr, mask - _info.begin));
+      return;
+    }
+    auto ptr = element_at(first);
+    for (uint64_t idx = first; idx < last; ++idx, ptr = advance(ptr, _step))
+      func(*ptr);
+  }
+
+  // Copy elements in view order into dense buffer of at least size() items
+  void gather(T* out) const {
+    for_each([&out](const T& elem) { *out++ = elem; });
+  }
+
+  // Overwrite elements in view order from dense buffer of size() items
+  void scatter(const T* in) const {
+    for_each([&in](T& elem) { elem = *in++; });
+  }
 
-  const_iterator cbegin() const { return const_iterator(_ptr, _step, _info); }
-  const_iterator cend() const {
-    return const_iterator(_end, _step, _info + (_end - _ptr));
+  iterator begin() const {
+    if (_step != MASK) return iterator(_ptr, _step, _info, _pitch);
+    // Masked view starts at its first valid entry
+    auto first = static_cast<int64_t>(_info.select(0));
+    return iterator(advance(_ptr, first), _step, _info + first, _pitch);
   }
 
+  iterator end() const {
+    return iterator(_end, _step, _info + distance(_ptr, _end), _pitch);
+  }
+
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
   View operator()(Range rng) {
-    return rng._start > rng._stop
-               ? View(_ptr + rng._start, 0, rng._step)
-               : View(_ptr + rng._start,
-                      static_cast<uint64_t>(rng._stop - rng._start), rng._step);
+    // Open ranges (StepRange, StartRange) end with the view
+    auto extent = static_cast<RangeT>(std::abs(distance(_ptr, _end)));
+    auto stop = std::min(rng._stop, extent);
+    auto first = advance(_ptr, rng._start);
+    return rng._start > stop
+               ? View(first, 0, rng._step, _pitch, resource())
+               : View(first, static_cast<uint64_t>(stop - rng._start),
+                      rng._step, _pitch, resource());
+  }
+
+  View operator()(std::span<const MaskT> mask) {
+    if (_size < mask.size()) return View(_ptr, 0, STEP, _pitch, resource());
+    return View(_ptr, Mask(mask.begin(), mask.end(), resource()), _pitch);
+  }
+
+  View operator()(Mask&& mask) {
+    if (_size < mask.size()) return View(_ptr, 0, STEP, _pitch, resource());
+    return View(_ptr, std::move(mask), _pitch);
+  }
+
+  // Elements [first, last) of the view in view order, unlike Range which is
+  // relative to the viewed memory. Masked views copy the part of their mask
+  View subview(uint64_t first, uint64_t last) const {
+    last = std::min(last, size());
+    first = std::min(first, last);
+    if (_step == MASK) {
+      auto begin = _info.select(first);
+      auto end = _info.select(last);
+      auto entries = _info.begin + begin;
+      return View(advance(_ptr, static_cast<int64_t>(begin)),
+                  Mask(entries, entries + (end - begin), resource()), _pitch);
+    }
+    auto count = last - first;
+    auto step_abs = static_cast<uint64_t>(std::abs(_step));
+    if (count == 0)
+      return View(element_at(first), 0, _step, _pitch, resource());
+    auto lowest = element_at(_step > 0 ? first : last - 1);
+    return View(lowest, (count - 1) * step_abs + 1, _step, _pitch, resource());
   }
 
-  View operator()(const std::vector<uint8_t>& mask) {
-    if (_size < mask.size()) return View(_ptr, 0);
-    return View(_ptr, mask);
+  // Multi-dimensional view of the same elements, single axis can be -1 and is
+  // deduced from the others. Masked views and fields of records with size not
+  // being a multiple of the member size can not be reshaped
+  template <typename... Dims>
+  NdView<T, sizeof...(Dims)> reshape(Dims... dims) const {
+    constexpr auto size = static_cast<int64_t>(sizeof(T));
+    if (_step == MASK || _pitch % size != 0) return {};
+    auto stride = _step * (_pitch / size);
+    return NdView<T, 1>(data(), {_size}, {stride}).reshape(dims...);
   }
 
   reference operator[](uint64_t idx) { return *element_at(idx); }
 
   const_reference operator[](uint64_t idx) const { return *element_at(idx); }
 
-  friend std::vector<uint8_t> operator<(const View& view, const T& val) {
-    std::vector<uint8_t> mask;
-    mask.resize(view.size());
+  friend Mask operator<(const View& view, const T& val) {
+    Mask mask(view.size(), view.resource());
     uint64_t idx = 0;
     for (const auto& elem : view)
       mask.at(idx++) = elem < val ? MASK_TRUE : MASK_FALSE;
@@ -99,35 +265,127 @@ class View {
   }
 
   const T& operator=(const T& value) {
-    auto p = _ptr;
-    while (p != _end) *p++ = value;
+    for_each([&value](T& elem) { elem = value; });
     return value;
   }
 
+  // Overlapping views are handled as if the source was copied first
   const View& operator=(const View& value) {
     // TODO throw?
-    if (value.size() == size()) {
-      auto p = _ptr;
-      auto r = value._ptr;
-      while (p != _end) *p++ = *r++;
-    }
+    if (value.size() == size() && size() != 0) assign(value);
     return value;
   }
 
  protected:
   T* element_at(uint64_t idx) const {
     if (_step == MASK) {
-      return _ptr + _info.next(idx);
+      return advance(_ptr, static_cast<int64_t>(_info.select(idx)));
+    }
+    return advance(_ptr,
+                   static_cast<int64_t>(idx) * _step + (_step < 0 ? _step : 0));
+  }
+
+  pointer advance(pointer ptr, int64_t positions) const {
+    return offset_bytes(ptr, positions * _pitch);
+  }
+
+  int64_t distance(pointer from, pointer to) const {
+    return bytes_between(from, to) / _pitch;
+  }
+
+  // Lowest and past the highest byte of viewed memory, masked views cover all
+  // their positions
+  std::pair<const char*, const char*> footprint() const {
+    auto lowest = reinterpret_cast<const char*>(origin());
+    auto extent = static_cast<int64_t>(this->extent());
+    if (extent == 0) return {lowest, lowest};
+    auto last = (extent - 1) * (_step == MASK ? 1 : std::abs(_step));
+    return {lowest, lowest + last * _pitch + sizeof(T)};
+  }
+
+  // Strategy depends on how the views overlap. Disjoint views are copied
+  // directly, views with the same stride are copied in the direction which
+  // reads every element before it is overwritten, reversal of the same
+  // elements swaps pairs in place. Only other overlaps are staged
+  void assign(const View& value) {
+    auto count = size();
+    auto [lowest, highest] = footprint();
+    auto [value_lowest, value_highest] = value.footprint();
+    bool overlap = lowest < value_highest && value_lowest < highest;
+    if (!masked() && !value.masked()) {
+      if constexpr (std::is_trivially_copyable_v<T>)
+        if (contiguous() && value.contiguous()) {
+          std::memmove(data(), value.data(), count * sizeof(T));
+          return;
+        }
+      auto stride = _step * _pitch;
+      auto value_stride = value._step * value._pitch;
+      if (!overlap || stride == value_stride) {
+        // Target ahead of the source in walking direction is copied backwards
+        auto ahead = bytes_between(value.data(), data());
+        bool backward = overlap && ahead != 0 && (ahead > 0) == (stride > 0);
+        copy_strided(data(), stride, value.data(), value_stride, count,
+                     backward);
+        return;
+      }
+      if (stride == -value_stride && data() == value.element_at(count - 1)) {
+        for (uint64_t idx = 0; idx < count / 2; ++idx)
+          std::swap(*element_at(idx), *element_at(count - 1 - idx));
+        return;
+      }
+    } else if (!overlap) {
+      auto source = value.begin();
+      for_each([&source](T& elem) { elem = *source++; });
+      return;
     }
-    return _ptr + static_cast<int64_t>(idx) * _step + (_step < 0 ? _step : 0);
+    auto buffer = scratch<std::remove_const_t<T>>(count);
+    value.gather(buffer.data());
+    scatter(buffer.data());
+  }
+
+  static void copy_strided(pointer dst, int64_t dst_stride, pointer src,
+                           int64_t src_stride, uint64_t count, bool backward) {
+    auto copy = [&](uint64_t idx) {
+      auto position = static_cast<int64_t>(idx);
+      *offset_bytes(dst, position * dst_stride) =
+          *offset_bytes(src, position * src_stride);
+    };
+    if (backward)
+      for (uint64_t idx = count; idx-- > 0;) copy(idx);
+    else
+      for (uint64_t idx = 0; idx < count; ++idx) copy(idx);
   }
 
+
  private:
+  View(pointer ptr, uint64_t size, int64_t step, int64_t pitch,
+       std::pmr::memory_resource* resource)
+      : _step(validate_step(step)),
+        _pitch(pitch),
+        _size(elements(size, step)),
+        _mask(resource) {
+    // Boundaries as in base_ptr and end_ptr, measured in pitches
+    auto span = static_cast<int64_t>(_size) * std::abs(_step);
+    _ptr = _step > 0 ? ptr : advance(ptr, span);
+    _end = _step < 0 ? ptr : advance(ptr, span);
+  }
+
+  View(pointer ptr, Mask mask, int64_t pitch, Threads threads = {})
+      : _ptr(ptr),
+        _step(MASK),
+        _pitch(pitch),
+        _info(mask, mask.get_allocator().resource(), threads),
+        _mask(std::move(mask)) {
+    _end = advance(ptr, static_cast<int64_t>(_mask.size()));
+    _size = _info.count();
+  }
+
   pointer _ptr = nullptr;
   pointer _end = nullptr;
   int64_t _step = 1;
+  int64_t _pitch = sizeof(T);
   uint64_t _size = 0;
   MaskInfo _info;
-  std::vector<uint8_t> _mask;
+  Mask _mask;
 };
 }  // namespace SeqView
\ No newline at end of file
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <sequence_view/view.hpp>
+#include <tuple>
+#include <utility>
+
+namespace SeqView {
+// Lockstep iteration over views of equal size yielding tuples of references.
+// Views with the same step or the same mask share a single cursor, other
+// combinations fall back to an iterator per view
+template <typename... Ts>
+class Zip {
+  static_assert(sizeof...(Ts) > 0, "Zip requires at least one view");
+
+ public:
+  enum class Layout { Strided, Masked, Mixed };
+
+  using value_type = std::tuple<Ts&...>;
+
+  class iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::tuple<Ts&...>;
+    using reference = value_type;
+
+    iterator() = default;
+
+    reference operator*() const {
+      if (_zip->_layout == Layout::Mixed)
+        return std::apply([](const auto&... its) { return reference(*its...); },
+                          _its);
+      return _zip->at(_pos, std::index_sequence_for<Ts...>());
+    }
+
+    iterator& operator++() {
+      ++_pos;
+      if (_zip->_layout == Layout::Masked) {
+        auto mask = _zip->mask_entries();
+        while (_pos < _zip->_extent && mask[_pos] != MASK_TRUE) ++_pos;
+      } else if (_zip->_layout == Layout::Mixed) {
+        std::apply([](auto&... its) { (++its, ...); }, _its);
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const iterator& lhs, const iterator& rhs) {
+      return lhs._pos == rhs._pos;
+    }
+
+   private:
+    friend class Zip;
+
+    const Zip* _zip = nullptr;
+    // Index for strided layout, mask position for masked one, element count
+    // for mixed one
+    uint64_t _pos = 0;
+    std::tuple<BaseIterator<Ts>...> _its;
+  };
+
+  explicit Zip(View<Ts>... views) : _views(std::move(views)...) {
+    auto& first = std::get<0>(_views);
+    auto same_size = std::apply(
+        [&](const auto&... view) {
+          return ((view.size() == first.size()) && ...);
+        },
+        _views);
+    _size = same_size ? first.size() : 0;
+
+    auto same_step = std::apply(
+        [&](const auto&... view) {
+          return ((!view.masked() && view.step() == first.step()) && ...);
+        },
+        _views);
+    auto same_mask = std::apply(
+        [&](const auto&... view) {
+          return ((view.masked() && same_entries(view.mask(), first.mask())) &&
+                  ...);
+        },
+        _views);
+
+    _dense = std::apply(
+        [](const auto&... view) { return (view.contiguous() && ...); },
+        _views);
+    if (same_step) {
+      _layout = Layout::Strided;
+      _extent = _size;
+      _bases = std::apply(
+          [](const auto&... view) { return std::make_tuple(view.data()...); },
+          _views);
+      _strides = std::apply(
+          [](const auto&... view) {
+            return std::array{(view.step() * view.pitch())...};
+          },
+          _views);
+    } else if (same_mask) {
+      _layout = Layout::Masked;
+      _extent = first.extent();
+      _bases = std::apply(
+          [](const auto&... view) { return std::make_tuple(view.origin()...); },
+          _views);
+      _strides = std::apply(
+          [](const auto&... view) { return std::array{view.pitch()...}; },
+          _views);
+    }
+  }
+
+  uint64_t size() const { return _size; }
+
+  Layout layout() const { return _layout; }
+
+  iterator begin() const {
+    iterator it;
+    it._zip = this;
+    if (_layout == Layout::Masked) {
+      it._pos = std::get<0>(_views).mask().select(0);
+    } else if (_layout == Layout::Mixed) {
+      it._its = std::apply(
+          [](const auto&... view) { return std::make_tuple(view.begin()...); },
+          _views);
+    }
+    return it;
+  }
+
+  iterator end() const {
+    iterator it;
+    it._zip = this;
+    it._pos = _layout == Layout::Masked ? _extent : _size;
+    return it;
+  }
+
+  // Visit tuples as func(elements...), single index or mask loop when layouts
+  // of views match
+  template <typename Func>
+  void for_each(Func&& func) const {
+    if (_layout == Layout::Strided) {
+      if (_dense) {
+        std::apply(
+            [&](auto*... ptrs) {
+              for (uint64_t idx = 0; idx < _size; ++idx) func(ptrs[idx]...);
+            },
+            _bases);
+        return;
+      }
+      for (uint64_t idx = 0; idx < _size; ++idx)
+        std::apply(func, at(idx, std::index_sequence_for<Ts...>()));
+      return;
+    }
+    if (_layout == Layout::Masked) {
+      auto mask = mask_entries();
+      for (uint64_t pos = 0; pos < _extent; ++pos)
+        if (mask[pos] == MASK_TRUE)
+          std::apply(func, at(pos, std::index_sequence_for<Ts...>()));
+      return;
+    }
+    for (auto it = begin(); it != end(); ++it) std::apply(func, *it);
+  }
+
+ private:
+  static bool same_entries(const MaskInfo& lhs, const MaskInfo& rhs) {
+    return lhs.end - lhs.begin == rhs.end - rhs.begin &&
+           (lhs.begin == rhs.begin ||
+            std::equal(lhs.begin, lhs.end, rhs.begin));
+  }
+
+  // Elements at index of strided layout or position of masked one
+  template <std::size_t... Is>
+  value_type at(uint64_t pos, std::index_sequence<Is...>) const {
+    auto offset = static_cast<int64_t>(pos);
+    return value_type(
+        *offset_bytes(std::get<Is>(_bases), offset * _strides[Is])...);
+  }
+
+  // Owned by the copy of the first view, so it follows copies of zip
+  const MaskT* mask_entries() const { return std::get<0>(_views).mask().begin; }
+
+  std::tuple<View<Ts>...> _views;
+  uint64_t _size = 0;
+  Layout _layout = Layout::Mixed;
+  // All views are contiguous, elements share a plain index
+  bool _dense = false;
+  uint64_t _extent = 0;
+  std::tuple<Ts*...> _bases;
+  // Bytes between elements of every view
+  std::array<int64_t, sizeof...(Ts)> _strides{};
+};
+
+template <typename... Ts>
+Zip<Ts...> zip(const View<Ts>&... views) {
+  return Zip<Ts...>(views...);
+}
+}  // namespace SeqView
@@ -0,0 +1,61 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/array.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/sort.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+static uint64_t address(const void* ptr) {
+  return reinterpret_cast<uint64_t>(ptr);
+}
+
+TEST(Array, AlignedAndValueInitialized) {
+  SeqView::Array<float> array(1000);
+  EXPECT_THAT(array.size(), Eq(1000));
+  EXPECT_THAT(address(array.data()) % SeqView::CACHE_LINE, Eq(0));
+  EXPECT_THAT(array, Each(0.0f));
+
+  SeqView::Array<double, 32> vector_aligned(5, 1.5);
+  EXPECT_THAT(decltype(vector_aligned)::alignment(), Eq(32));
+  EXPECT_THAT(address(vector_aligned.data()) % 32, Eq(0));
+  EXPECT_THAT(vector_aligned, ElementsAre(1.5, 1.5, 1.5, 1.5, 1.5));
+}
+
+TEST(Array, HugePagesWithParallelFirstTouch) {
+  SeqView::Threads threads{4, 1000};
+  SeqView::Array<uint32_t> array(100000, 7U, SeqView::Pages::Huge, threads);
+  EXPECT_THAT(array.pages(), Eq(SeqView::Pages::Huge));
+  EXPECT_THAT(address(array.data()) % SeqView::HUGE_PAGE, Eq(0));
+  EXPECT_THAT(array, Each(7U));
+}
+
+TEST(Array, ConvertsToView) {
+  SeqView::Array<int> array(6);
+  std::iota(array.begin(), array.end(), 0);
+  SeqView::View<int> view = array;
+  EXPECT_THAT(view.data(), Eq(array.data()));
+  EXPECT_TRUE(view.contiguous());
+  view(SeqView::Range{0, 6, -2}) = 9;
+  EXPECT_THAT(array, ElementsAre(9, 1, 9, 3, 9, 5));
+  SeqView::sort(array.view());
+  EXPECT_THAT(array, ElementsAre(1, 3, 5, 9, 9, 9));
+  SeqView::View<const int> readonly = array;
+  EXPECT_THAT(readonly, SizeIs(6));
+}
+
+TEST(Array, MoveTransfersOwnership) {
+  SeqView::Array<uint64_t> array(3, 9);
+  auto data = array.data();
+  SeqView::Array<uint64_t> other(std::move(array));
+  EXPECT_THAT(other.data(), Eq(data));
+  EXPECT_TRUE(array.empty());
+  array = std::move(other);
+  EXPECT_THAT(array, ElementsAre(9, 9, 9));
+  EXPECT_THAT(SeqView::Array<uint64_t>().data(), IsNull());
+}
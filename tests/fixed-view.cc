@@ -0,0 +1,86 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <sequence_view/fixed-view.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+static_assert(sizeof(SeqView::FixedView<double, 16>) == sizeof(double*));
+static_assert(SeqView::FixedView<int, 4, -2>::EXTENT == 8);
+static_assert(SeqView::FixedView<int, 4, -2>::FIRST == 6);
+
+constexpr int sum_of_odd() {
+  int data[] = {0, 1, 2, 3, 4, 5, 6, 7};
+  SeqView::FixedView<int, 4, 2> odd(data + 1);
+  return odd.reduce(0, std::plus<>());
+}
+static_assert(sum_of_odd() == 16);
+
+constexpr int last_of_reversed() {
+  int data[] = {0, 1, 2, 3, 4, 5};
+  SeqView::FixedView reversed = SeqView::FixedView<int, 6, -1>(data);
+  reversed.subview<2>(1) = 9;
+  return reversed[0] * 100 + data[3] * 10 + data[4];
+}
+static_assert(last_of_reversed() == 599);
+
+TEST(FixedView, StepsAndIteration) {
+  uint64_t data[12];
+  std::iota(data, data + 12, 0);
+  SeqView::FixedView<uint64_t, 4, 3> forward(data);
+  EXPECT_THAT(forward, ElementsAre(0, 3, 6, 9));
+  SeqView::FixedView<uint64_t, 4, -3> backward(data);
+  EXPECT_THAT(backward, ElementsAre(9, 6, 3, 0));
+  EXPECT_THAT(backward[1], Eq(6));
+  EXPECT_THAT(backward.subview<2>(1), ElementsAre(6, 3));
+  EXPECT_THAT((backward.subview<2, 2>(0)), ElementsAre(9, 3));
+  EXPECT_THAT(std::accumulate(backward.begin(), backward.end(), 0), Eq(18));
+  EXPECT_THAT(backward.end() - backward.begin(), Eq(4));
+
+  SeqView::FixedView whole(data);
+  EXPECT_THAT(whole.size(), Eq(12));
+  EXPECT_TRUE(whole.contiguous());
+  std::reverse(forward.begin(), forward.end());
+  EXPECT_THAT(data, ElementsAre(9, 1, 2, 6, 4, 5, 3, 7, 8, 0, 10, 11));
+
+  SeqView::FixedView<const uint64_t, 4, 3> frozen = forward;
+  EXPECT_THAT(frozen.gather(), ElementsAre(9, 6, 3, 0));
+}
+
+TEST(FixedView, AssignAndConvert) {
+  uint64_t data[8];
+  std::iota(data, data + 8, 0);
+  SeqView::FixedView<uint64_t, 8> all(data);
+  // Overlapping views are copied through a local array
+  SeqView::FixedView<uint64_t, 8, -1>{data} = all;
+  EXPECT_THAT(data, ElementsAre(7, 6, 5, 4, 3, 2, 1, 0));
+  all.subview<4>(2) = all.subview<4>(0);
+  EXPECT_THAT(data, ElementsAre(7, 6, 7, 6, 5, 4, 1, 0));
+  SeqView::FixedView<uint64_t, 4, 2>{data} = 1;
+  EXPECT_THAT(data, ElementsAre(1, 6, 1, 6, 1, 4, 1, 0));
+
+  SeqView::View<uint64_t> view = SeqView::FixedView<uint64_t, 3, -2>(data + 1);
+  EXPECT_THAT(view, ElementsAre(4, 6, 6));
+  EXPECT_THAT(view.step(), Eq(-2));
+}
+
+TEST(FixedView, TilesOfMatrix) {
+  float tile[64];
+  std::iota(tile, tile + 64, 0.0f);
+  for (uint64_t row = 0; row < 8; ++row) {
+    SeqView::FixedView<float, 8> values(tile + row * 8);
+    EXPECT_THAT(values.reduce(0.0f, std::plus<>()), Eq(64.0f * row + 28.0f));
+  }
+  for (uint64_t col = 0; col < 8; ++col) {
+    SeqView::FixedView<float, 8, 8> values(tile + col);
+    EXPECT_THAT(values.reduce(0.0f, std::plus<>()), Eq(224.0f + 8.0f * col));
+  }
+  SeqView::FixedView<float, 8, 9> diagonal(tile);
+  EXPECT_THAT(diagonal, ElementsAre(0, 9, 18, 27, 36, 45, 54, 63));
+}
@@ -0,0 +1,71 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/histogram.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Histogram, UniformBins) {
+  double data[] = {0.0, 0.5, 1.0, 2.5, 3.9, 4.0, -1.0, 4.5, 1.5, 2.0};
+  uint64_t expected[] = {2, 2, 1, 1, 2};
+  SeqView::View view(data, 10);
+  auto counts = SeqView::histogram(view, 5, 0.0, 4.0);
+  EXPECT_THAT(counts, ElementsAreArray(expected));
+}
+
+TEST(Histogram, UniformBinsStrided) {
+  uint64_t data[] = {1, 9, 2, 9, 3, 9, 4, 9, 5, 9};
+  uint64_t expected[] = {2, 1, 2};
+  SeqView::View view(data, 10);
+  auto counts = SeqView::histogram(view(SeqView::StepRange(2)), 3, 1.0, 5.0);
+  EXPECT_THAT(counts, ElementsAreArray(expected));
+}
+
+TEST(Histogram, EdgesWithMask) {
+  int data[] = {1, 7, 2, 8, 3, 5, 10, 4};
+  std::vector<uint8_t> mask{true, true, false, true, true, true, true, false};
+  std::vector<double> edges{0.0, 2.0, 5.0, 10.0};
+  uint64_t expected[] = {1, 1, 4};
+  SeqView::View view(data, 8);
+  auto counts = SeqView::histogram(view(mask), edges);
+  EXPECT_THAT(counts, ElementsAreArray(expected));
+}
+
+TEST(Histogram, Bincount) {
+  int data[] = {1, 3, 1, -2, 0, 3, 3};
+  uint64_t expected[] = {1, 2, 0, 3, 0, 0};
+  SeqView::View view(data, 7);
+  EXPECT_THAT(SeqView::bincount(view, 6), ElementsAreArray(expected));
+  EXPECT_THAT(SeqView::bincount(view), SizeIs(4));
+}
+
+TEST(Histogram, ParallelMatchesSerial) {
+  std::vector<uint32_t> data(100000);
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<uint32_t> dist(0, 999);
+  for (auto& elem : data) elem = dist(gen);
+  SeqView::View view(data.data(), data.size());
+  auto sub = view(SeqView::Range{7, 100000, -3});
+  SeqView::Threads threads{4, 1000};
+
+  auto serial = SeqView::histogram(sub, 37, 0.0, 1000.0);
+  auto parallel = SeqView::histogram(sub, 37, 0.0, 1000.0, threads);
+  EXPECT_THAT(parallel, ContainerEq(serial));
+  EXPECT_THAT(std::accumulate(serial.begin(), serial.end(), uint64_t(0)),
+              Eq(sub.size()));
+
+  std::vector<uint64_t> expected(500);
+  for (auto elem : data)
+    if (elem < 500) ++expected[elem];
+  auto masked = view(view < 500);
+  EXPECT_THAT(SeqView::bincount(masked, 0, threads),
+              ElementsAreArray(expected));
+}
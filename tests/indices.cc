@@ -0,0 +1,85 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <sequence_view/indices.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Indices, ArgMinMaxInBufferCoordinates) {
+  int data[] = {4, 9, 1, 9, 0, 7, 1, 3};
+  SeqView::View view(data, 8);
+  EXPECT_THAT(SeqView::argmax(view), Optional(1));
+  EXPECT_THAT(SeqView::argmin(view), Optional(4));
+
+  auto tail = view(SeqView::StartRange(5));
+  EXPECT_THAT(SeqView::argmin(tail), Optional(1));
+  EXPECT_THAT(SeqView::argmin(tail, data), Optional(6));
+
+  auto backward = view(SeqView::Range{0, 8, -2});
+  EXPECT_THAT(SeqView::argmax(backward, data), Optional(0));
+  std::vector<uint8_t> mask{false, false, true, true, false, true};
+  EXPECT_THAT(SeqView::argmax(view(mask)), Optional(3));
+  EXPECT_THAT(SeqView::argmin(view(SeqView::Range{0, 0})), Eq(std::nullopt));
+}
+
+TEST(Indices, WhereAndNonzero) {
+  std::vector<float> data(200);
+  std::iota(data.begin(), data.end(), 0.0f);
+  SeqView::View view(data.data(), data.size());
+  auto below = SeqView::where(view, [](float x) { return x < 3.0f; });
+  EXPECT_THAT(below, ElementsAre(0, 1, 2));
+  auto tail = view(SeqView::StartRange(100));
+  auto large = SeqView::where(tail, [](float x) { return x >= 197.0f; },
+                              data.data());
+  EXPECT_THAT(large, ElementsAre(197, 198, 199));
+
+  uint8_t flags[] = {0, 3, 0, 0, 1, 1, 0, 2};
+  SeqView::View vf(flags, 8);
+  EXPECT_THAT(SeqView::nonzero(vf), ElementsAre(1, 4, 5, 7));
+  EXPECT_THAT(SeqView::nonzero(vf(SeqView::Range{0, 8, -1})),
+              ElementsAre(7, 5, 4, 1));
+  std::vector<uint8_t> mask{true, true, false, false, true, true};
+  EXPECT_THAT(SeqView::nonzero(vf(mask)), ElementsAre(1, 4, 5));
+}
+
+TEST(Indices, WhereOnFields) {
+  struct Hit {
+    double energy;
+    int32_t channel;
+  };
+  std::vector<Hit> hits{{0.5, 1}, {2.5, 2}, {1.5, 3}, {3.5, 4}};
+  auto energy = SeqView::View<double>::field(hits, &Hit::energy);
+  EXPECT_THAT(SeqView::where(energy, [](double e) { return e > 1.0; }),
+              ElementsAre(1, 2, 3));
+  EXPECT_THAT(SeqView::argmax(energy), Optional(3));
+}
+
+TEST(Indices, TopK) {
+  int data[] = {5, 1, 9, 3, 9, 7, 2, 8};
+  SeqView::View view(data, 8);
+  EXPECT_THAT(SeqView::top_k(view, 3), ElementsAre(2, 4, 7));
+  EXPECT_THAT(SeqView::top_k(view, 2, std::less<>()), ElementsAre(1, 6));
+  EXPECT_THAT(SeqView::top_k(view, 20), SizeIs(8));
+  EXPECT_THAT(SeqView::top_k(view(SeqView::StepRange(2)), 2),
+              ElementsAre(2, 4));
+
+  std::vector<uint32_t> large(10000);
+  std::mt19937 gen(5);
+  for (auto& elem : large) elem = gen() % 100000;
+  SeqView::View vl(large.data(), large.size());
+  auto heap = SeqView::top_k(vl, 10);
+  auto partition = SeqView::top_k(vl, 5000);
+  EXPECT_THAT(heap,
+              ElementsAreArray(partition.begin(), partition.begin() + 10));
+  for (uint64_t idx = 1; idx < heap.size(); ++idx)
+    EXPECT_THAT(large[heap[idx - 1]], Ge(large[heap[idx]]));
+  EXPECT_THAT(large[heap[0]],
+              Eq(*std::max_element(large.begin(), large.end())));
+}
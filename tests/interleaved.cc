@@ -0,0 +1,85 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/interleaved.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Interleaved, ChannelViews) {
+  uint8_t rgb[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  SeqView::Interleaved<uint8_t, 3> pixels(rgb, 3);
+  EXPECT_THAT(pixels.channel(0), ElementsAre(1, 4, 7));
+  EXPECT_THAT(pixels.channel(2), ElementsAre(3, 6, 9));
+  EXPECT_THAT(pixels.channel(3), SizeIs(0));
+  EXPECT_THAT(pixels(1, 1), Eq(5));
+}
+
+TEST(Interleaved, StereoRoundTrip) {
+  // 4 frames at once with shuffles, remaining 3 frames one by one
+  std::vector<float> samples(14);
+  std::iota(samples.begin(), samples.end(), 0.0f);
+  SeqView::Interleaved<const float, 2> stereo(samples.data(), 7);
+  std::vector<float> left(7), right(7);
+  SeqView::View vl(left.data(), 7);
+  SeqView::View vr(right.data(), 7);
+  stereo.deinterleave(vl, vr);
+  EXPECT_THAT(left, ElementsAre(0, 2, 4, 6, 8, 10, 12));
+  EXPECT_THAT(right, ElementsAre(1, 3, 5, 7, 9, 11, 13));
+
+  std::vector<float> mixed(14);
+  SeqView::Interleaved<float, 2>(mixed.data(), 7).interleave(vl, vr);
+  EXPECT_THAT(mixed, ElementsAreArray(samples));
+}
+
+TEST(Interleaved, FourChannelsTranspose) {
+  std::vector<int32_t> samples(4 * 9);
+  std::iota(samples.begin(), samples.end(), 0);
+  SeqView::Interleaved<int32_t, 4> rgba(samples.data(), 9);
+  std::vector<int32_t> planes(4 * 9);
+  std::array<SeqView::View<int32_t>, 4> views{
+      SeqView::View(planes.data(), 9), SeqView::View(planes.data() + 9, 9),
+      SeqView::View(planes.data() + 18, 9),
+      SeqView::View(planes.data() + 27, 9)};
+  std::apply([&](const auto&... view) { rgba.deinterleave(view...); }, views);
+  for (std::size_t channel = 0; channel < 4; ++channel)
+    EXPECT_THAT(views[channel], ElementsAreArray(rgba.channel(channel)));
+
+  std::vector<int32_t> restored(4 * 9);
+  SeqView::Interleaved<int32_t, 4> target(restored.data(), 9);
+  std::apply([&](const auto&... view) { target.interleave(view...); }, views);
+  EXPECT_THAT(restored, ElementsAreArray(samples));
+}
+
+TEST(Interleaved, StridedAndMaskedChannels) {
+  uint16_t iq[] = {1, 10, 2, 20, 3, 30};
+  SeqView::Interleaved<uint16_t, 2> signal(iq, 3);
+  uint16_t out[6] = {};
+  SeqView::View vo(out, 6);
+  std::vector<uint8_t> mask{false, true, false, true, false, true};
+  auto in_phase = vo(SeqView::Range{0, 6, -2});
+  auto quadrature = vo(mask);
+  signal.deinterleave(in_phase, quadrature);
+  EXPECT_THAT(out, ElementsAre(3, 10, 2, 20, 1, 30));
+  signal.deinterleave(vo, vo);
+  EXPECT_THAT(out, ElementsAre(3, 10, 2, 20, 1, 30));
+
+  SeqView::Interleaved<uint16_t, 2>(iq, 3).interleave(quadrature, in_phase);
+  EXPECT_THAT(iq, ElementsAre(10, 1, 20, 2, 30, 3));
+}
+
+TEST(Interleaved, ReduceAllChannelsAtOnce) {
+  double audio[] = {1.0, -1.0, 2.0, -2.0, 3.0, -4.0};
+  SeqView::Interleaved<double, 2> stereo(audio, 3);
+  auto sums = stereo.reduce(std::array<double, 2>{}, std::plus<>());
+  EXPECT_THAT(sums, ElementsAre(6.0, -7.0));
+  auto peaks = stereo.reduce(std::array<double, 2>{0.0, 0.0},
+                             [](double acc, double sample) {
+                               return std::max(acc, std::abs(sample));
+                             });
+  EXPECT_THAT(peaks, ElementsAre(3.0, 4.0));
+}
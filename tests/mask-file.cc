@@ -0,0 +1,96 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sequence_view/mask-file.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+static std::string temp_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<uint8_t> sparse_mask(uint64_t size) {
+  std::vector<uint8_t> mask(size);
+  for (uint64_t idx = 0; idx < size; ++idx) mask[idx] = idx % 7 == 3;
+  return mask;
+}
+
+TEST(MaskFile, BytesAreUsedInPlace) {
+  auto path = temp_path("seqview-bytes.mask");
+  auto mask = sparse_mask(300);
+  ASSERT_TRUE(SeqView::save_mask(path, mask));
+
+  std::vector<uint64_t> data(300);
+  std::iota(data.begin(), data.end(), 0);
+  std::optional<SeqView::View<uint64_t>> view;
+  {
+    SeqView::MaskFile file(path);
+    ASSERT_TRUE(file.good());
+    EXPECT_THAT(file.encoding(), Eq(SeqView::MaskEncoding::Bytes));
+    EXPECT_THAT(file.size(), Eq(300));
+    EXPECT_THAT(file.count(), Eq(43));
+    view.emplace(SeqView::View<uint64_t>::from_mask(data.data(), file.mask()));
+    SeqView::View<uint64_t> copy(*view);
+    EXPECT_THAT(copy.mask().begin, Eq(file.mask().begin));
+  }
+  // Mapping is kept alive by the view
+  EXPECT_THAT(view->size(), Eq(43));
+  EXPECT_THAT((*view)[0], Eq(3));
+  EXPECT_THAT((*view)[42], Eq(297));
+  EXPECT_THAT(view->mask().rank(150), Eq(21));
+  std::filesystem::remove(path);
+}
+
+TEST(MaskFile, PackedEncodingsRoundTrip) {
+  auto mask = sparse_mask(1000);
+  mask[999] = true;
+  SeqView::MaskInfo info(mask);
+  for (auto encoding : {SeqView::MaskEncoding::Bits,
+                        SeqView::MaskEncoding::Runs}) {
+    auto path = temp_path("seqview-packed.mask");
+    ASSERT_TRUE(SeqView::save_mask(path, info, encoding));
+    SeqView::MaskFile file(path);
+    ASSERT_TRUE(file.good());
+    EXPECT_THAT(file.encoding(), Eq(encoding));
+    EXPECT_THAT(file.count(), Eq(info.count()));
+    const auto& loaded = file.mask();
+    EXPECT_TRUE(std::equal(mask.begin(), mask.end(), loaded.begin));
+    EXPECT_THAT(loaded.select(100), Eq(info.select(100)));
+    std::filesystem::remove(path);
+  }
+  auto bits = temp_path("seqview-bits.mask");
+  auto bytes = temp_path("seqview-bytes.mask");
+  SeqView::save_mask(bits, info, SeqView::MaskEncoding::Bits);
+  SeqView::save_mask(bytes, info, SeqView::MaskEncoding::Bytes);
+  EXPECT_THAT(std::filesystem::file_size(bits),
+              Lt(std::filesystem::file_size(bytes)));
+  std::filesystem::remove(bits);
+  std::filesystem::remove(bytes);
+}
+
+TEST(MaskFile, RejectsMalformedFiles) {
+  EXPECT_FALSE(SeqView::MaskFile(temp_path("seqview-missing.mask")).good());
+
+  auto path = temp_path("seqview-broken.mask");
+  auto mask = sparse_mask(100);
+  ASSERT_TRUE(SeqView::save_mask(path, mask));
+  std::filesystem::resize_file(path, 150);
+  EXPECT_FALSE(SeqView::MaskFile(path).good());
+
+  ASSERT_TRUE(SeqView::save_mask(path, mask));
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    uint32_t version = SeqView::MASK_VERSION + 1;
+    file.seekp(8);
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  }
+  EXPECT_FALSE(SeqView::MaskFile(path).good());
+  std::filesystem::remove(path);
+}
@@ -3,6 +3,8 @@
 #include <gtest/gtest-matchers.h>
 #include <gtest/gtest.h>
 
+#include <array>
+#include <memory_resource>
 #include <numeric>
 #include <sequence_view/base-iterator.hpp>
 #include <sequence_view/mask.hpp>
@@ -31,7 +33,47 @@ TEST(SubView, CheckValidUntil) {
   SeqView::View view(data, 10);
   auto mask = view < 5;
   SeqView::MaskInfo info(mask);
-  EXPECT_THAT(info.valid_until, ContainerEq(expected));
+  EXPECT_THAT(info.valid_until, ElementsAre(0, 6));
+  for (uint64_t idx = 0; idx < expected.size(); ++idx)
+    EXPECT_THAT(info.rank(idx), Eq(expected[idx]))
+        << fmt::format("Failed for idx {}", idx);
+}
+
+TEST(SubView, RankAndSelectOverBlocks) {
+  std::vector<uint8_t> mask(1000);
+  for (uint64_t idx = 0; idx < mask.size(); ++idx)
+    mask[idx] = (idx * 7919) % 13 < 4 ? SeqView::MASK_TRUE
+                                      : SeqView::MASK_FALSE;
+  std::vector<uint64_t> positions;
+  for (uint64_t idx = 0; idx < mask.size(); ++idx)
+    if (mask[idx] == SeqView::MASK_TRUE) positions.push_back(idx);
+
+  SeqView::MaskInfo info(mask);
+  SeqView::MaskInfo parallel(mask, std::pmr::get_default_resource(),
+                             SeqView::Threads{4, 100});
+  EXPECT_THAT(info.count(), Eq(positions.size()));
+  EXPECT_THAT(parallel.valid_until, ElementsAreArray(info.valid_until));
+  for (uint64_t ordinal = 0; ordinal < positions.size(); ++ordinal) {
+    EXPECT_THAT(info.select(ordinal), Eq(positions[ordinal]));
+    EXPECT_THAT(info.rank(positions[ordinal]), Eq(ordinal));
+  }
+  EXPECT_THAT(info.select(positions.size()), Eq(mask.size()));
+}
+
+TEST(SubView, SubViewWithLeadingInvalid) {
+  uint64_t data[] = {1, 3, 7, 5, 4, 2, 1, 3, 6, 8};
+  uint64_t expected[] = {7, 5, 6, 8};
+  std::vector<uint8_t> mask{false, false, true,  true, false,
+                            false, false, false, true, true};
+  SeqView::View view(data, 10);
+  auto sub = view(mask);
+  EXPECT_THAT(sub.size(), Eq(4));
+  EXPECT_THAT(sub, ElementsAreArray(expected));
+  EXPECT_THAT(sub.end() - sub.begin(), Eq(4));
+  EXPECT_THAT(*(sub.end() - 4), Eq(7));
+  EXPECT_THAT(*(sub.begin() + 3), Eq(8));
+  for (auto idx = 0U; idx < sub.size(); ++idx)
+    EXPECT_THAT(sub[idx], Eq(expected[idx]));
 }
 
 TEST(SubView, SubViewWithMask) {
@@ -62,4 +104,37 @@ TEST(SubView, SubViewWithIteratorsAndMask) {
     EXPECT_THAT(*it, Eq(expected[idx]))
         << fmt::format("Failed for idx {}", idx);
   }
-}
\ No newline at end of file
+}
+TEST(SubView, CopyKeepsOwnMask) {
+  uint64_t data[] = {1, 3, 7, 5, 4, 2, 1, 3, 6, 8};
+  uint64_t expected[] = {1, 3, 4, 2, 1, 3};
+  SeqView::View view(data, 10);
+  auto sub = std::make_unique<SeqView::View<uint64_t>>(view(view < 5));
+  SeqView::View<uint64_t> copy(*sub);
+  sub.reset();
+  EXPECT_THAT(copy.size(), Eq(6));
+  EXPECT_THAT(copy, ElementsAreArray(expected));
+}
+
+TEST(SubView, MaskTemporariesUseViewResource) {
+  struct DefaultResourceGuard {
+    std::pmr::memory_resource* previous =
+        std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    ~DefaultResourceGuard() { std::pmr::set_default_resource(previous); }
+  };
+
+  uint64_t data[] = {1, 3, 7, 5, 4, 2, 1, 3, 6, 8};
+  uint64_t expected[] = {1, 3, 4, 2, 1, 3};
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  DefaultResourceGuard guard;
+  SeqView::View view(data, 10, SeqView::STEP, &arena);
+  auto sub = view(view < 5);
+  SeqView::View<uint64_t> copy(sub);
+  EXPECT_THAT(copy.resource(), Eq(&arena));
+  uint64_t idx = 0;
+  for (auto it = copy.begin(); it != copy.end(); ++it, ++idx)
+    EXPECT_THAT(*it, Eq(expected[idx]));
+  EXPECT_THAT(idx, Eq(6));
+}
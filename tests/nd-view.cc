@@ -0,0 +1,86 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/nd-view.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(NdView, ReshapeDeducesAxis) {
+  uint64_t data[20];
+  std::iota(std::begin(data), std::end(data), 0);
+  SeqView::View view(data, 20);
+  auto matrix = view.reshape(-1, 5);
+  EXPECT_THAT(matrix.shape(), ElementsAre(4, 5));
+  EXPECT_THAT(matrix.strides(), ElementsAre(5, 1));
+  EXPECT_THAT(matrix(2, 3), Eq(13));
+  EXPECT_THAT(matrix.reshape(2, -1, 5).shape(), ElementsAre(2, 2, 5));
+}
+
+TEST(NdView, ReshapeInvalid) {
+  uint64_t data[20];
+  SeqView::View view(data, 20);
+  EXPECT_TRUE(view.reshape(-1, 3).empty());
+  EXPECT_TRUE(view.reshape(-1, -1).empty());
+  EXPECT_TRUE(view.reshape(4, 4).empty());
+  EXPECT_TRUE(view.reshape(4, 5).transpose().reshape(-1).empty());
+}
+
+TEST(NdView, ReshapeStridedView) {
+  uint64_t data[12];
+  std::iota(std::begin(data), std::end(data), 0);
+  SeqView::View view(data, 12);
+  auto matrix = view(SeqView::Range{0, 12, -2}).reshape(2, 3);
+  uint64_t expected[] = {10, 8, 6, 4, 2, 0};
+  std::vector<uint64_t> visited;
+  matrix.for_each([&](auto elem) { visited.push_back(elem); });
+  EXPECT_THAT(visited, ElementsAreArray(expected));
+}
+
+TEST(NdView, TransposeAndPermute) {
+  uint64_t data[24];
+  std::iota(std::begin(data), std::end(data), 0);
+  SeqView::NdView<uint64_t, 3> cube(data, {2, 3, 4});
+  auto transposed = cube.transpose();
+  EXPECT_THAT(transposed.shape(), ElementsAre(4, 3, 2));
+  EXPECT_THAT(transposed(3, 1, 1), Eq(cube(1, 1, 3)));
+  auto permuted = cube.permute({1, 2, 0});
+  EXPECT_THAT(permuted.shape(), ElementsAre(3, 4, 2));
+  EXPECT_THAT(permuted(2, 1, 1), Eq(cube(1, 2, 1)));
+  EXPECT_TRUE(cube.permute({0, 0, 1}).empty());
+}
+
+TEST(NdView, BroadcastRowToMatrix) {
+  uint64_t matrix_data[] = {1, 2, 3, 4, 5, 6};
+  uint64_t row_data[] = {10, 20, 30};
+  uint64_t out_data[6];
+  uint64_t expected[] = {11, 22, 33, 14, 25, 36};
+  SeqView::NdView<uint64_t, 2> matrix(matrix_data, {2, 3});
+  SeqView::NdView<uint64_t, 1> row(row_data, {3});
+
+  auto broadcasted = row.broadcast_to(SeqView::Shape<2>{2, 3});
+  EXPECT_THAT(broadcasted.strides(), ElementsAre(0, 1));
+  EXPECT_TRUE(row.broadcast_to(SeqView::Shape<2>{3, 2}).empty());
+
+  SeqView::NdView<uint64_t, 2> out(out_data, {2, 3});
+  SeqView::transform(matrix, row, out, std::plus<>{});
+  EXPECT_THAT(out_data, ElementsAreArray(expected));
+}
+
+TEST(NdView, MaxWithColumnIntoTransposed) {
+  int data[] = {1, 7, 3, 4, 2, 9};
+  int column[] = {3, 5};
+  int out[6];
+  int expected[] = {3, 5, 7, 5, 3, 9};
+  SeqView::NdView<int, 2> matrix(data, {2, 3});
+  SeqView::NdView<int, 2> col(column, {2, 1});
+  SeqView::NdView<int, 2> result(out, {3, 2});
+  SeqView::max(matrix, col, result.transpose());
+  EXPECT_THAT(out, ElementsAreArray(expected));
+}
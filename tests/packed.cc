@@ -0,0 +1,170 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/packed.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+// Bit by bit, lowest bits first
+template <unsigned Bits>
+static std::vector<uint8_t> pack_bits(const std::vector<uint32_t>& values) {
+  std::vector<uint8_t> bytes((values.size() * Bits + 7) / 8);
+  for (uint64_t idx = 0; idx < values.size(); ++idx)
+    for (unsigned bit = 0; bit < Bits; ++bit)
+      if (values[idx] >> bit & 1) {
+        auto position = idx * Bits + bit;
+        bytes[position / 8] |= static_cast<uint8_t>(1 << position % 8);
+      }
+  return bytes;
+}
+
+template <unsigned Bits>
+static std::vector<uint32_t> random_values(uint64_t count) {
+  std::mt19937 gen(Bits);
+  std::uniform_int_distribution<uint32_t> dist(0, (1ULL << Bits) - 1);
+  std::vector<uint32_t> values(count);
+  for (auto& value : values) value = dist(gen);
+  return values;
+}
+
+template <unsigned Bits>
+static void check_round_trip(uint64_t count) {
+  using Value = SeqView::detail::packed_t<Bits>;
+  auto values = random_values<Bits>(count);
+  auto bytes = pack_bits<Bits>(values);
+  SeqView::PackedView<Bits> packed(bytes.data(), count);
+  std::vector<Value> expected(values.begin(), values.end());
+
+  std::vector<Value> out(count);
+  packed.unpack(SeqView::View(out.data(), count));
+  EXPECT_THAT(out, ElementsAreArray(expected)) << Bits;
+  // Starts in the middle of a byte
+  auto tail = packed(SeqView::Range{5, static_cast<int64_t>(count)});
+  tail.unpack(SeqView::View(out.data(), count - 5));
+  EXPECT_TRUE(std::equal(out.begin(), out.end() - 5, expected.begin() + 5));
+  EXPECT_TRUE(std::equal(tail.begin(), tail.end(), expected.begin() + 5));
+
+  std::vector<uint8_t> stored(bytes.size());
+  SeqView::PackedView<Bits> target(stored.data(), count);
+  target.pack(SeqView::View(expected.data(), count));
+  EXPECT_THAT(stored, ElementsAreArray(bytes)) << Bits;
+  // Neighbours of partial bytes are kept
+  std::vector<Value> zeros(count - 8);
+  target(SeqView::Range{3, static_cast<int64_t>(count) - 5})
+      .pack(SeqView::View(zeros.data(), zeros.size()));
+  target.unpack(SeqView::View(out.data(), count));
+  EXPECT_TRUE(std::equal(out.begin(), out.begin() + 3, expected.begin()));
+  EXPECT_TRUE(std::all_of(out.begin() + 3, out.end() - 5,
+                          [](Value value) { return value == 0; }));
+  EXPECT_TRUE(std::equal(out.end() - 5, out.end(), expected.end() - 5));
+}
+
+TEST(Packed, RoundTripMatchesBitStream) {
+  check_round_trip<3>(1001);
+  check_round_trip<8>(1001);
+  check_round_trip<10>(1001);
+  check_round_trip<12>(1001);
+  check_round_trip<16>(1001);
+  check_round_trip<20>(1001);
+  check_round_trip<32>(1001);
+}
+
+TEST(Packed, RangesStepsAndMasks) {
+  std::vector<uint32_t> values(20);
+  std::iota(values.begin(), values.end(), 1000);
+  auto bytes = pack_bits<10>(values);
+  SeqView::PackedView<10> packed(bytes.data(), 20);
+  EXPECT_THAT(packed, SizeIs(20));
+  EXPECT_THAT(packed[7], Eq(1007));
+  EXPECT_THAT(packed(SeqView::Range{2, 12, 3}),
+              ElementsAre(1002, 1005, 1008, 1011));
+  EXPECT_THAT(packed(SeqView::Range{0, 10, -2}),
+              ElementsAre(1008, 1006, 1004, 1002, 1000));
+  EXPECT_THAT(packed(SeqView::Range{15, 40}),
+              ElementsAre(1015, 1016, 1017, 1018, 1019));
+
+  std::vector<uint8_t> mask{false, true, true, false, true};
+  auto masked = packed(SeqView::Range{10, 20})(mask);
+  EXPECT_TRUE(masked.masked());
+  EXPECT_THAT(masked, ElementsAre(1011, 1012, 1014));
+  EXPECT_THAT(masked.reduce(uint64_t(0)), Eq(3037));
+  std::vector<uint8_t> longer(21, true);
+  EXPECT_THAT(packed(longer), SizeIs(0));
+
+  SeqView::PackedView<10, const uint8_t> frozen(bytes.data(), 20, 5);
+  EXPECT_THAT(frozen, ElementsAre(1000, 1005, 1010, 1015));
+}
+
+TEST(Packed, WriteElements) {
+  std::vector<uint8_t> bytes(15);
+  SeqView::PackedView<12> packed(bytes.data(), 10);
+  packed = 0xABC;
+  EXPECT_THAT(packed, Each(Eq(0xABC)));
+  packed[3] = 0x123;
+  packed(SeqView::Range{1, 10, -3}) = 7;
+  EXPECT_THAT(packed, ElementsAre(0xABC, 7, 0xABC, 0x123, 7, 0xABC, 0xABC, 7,
+                                  0xABC, 0xABC));
+  // Values are cut to the width of samples
+  packed[9] = 0xF001;
+  EXPECT_THAT(packed[9], Eq(1));
+  EXPECT_THAT(packed[8], Eq(0xABC));
+
+  std::vector<uint16_t> values(10);
+  std::iota(values.begin(), values.end(), 100);
+  packed.pack(SeqView::View(values.data(), 10));
+  std::vector<uint8_t> mask{true, false, true};
+  packed(mask) = 0;
+  EXPECT_THAT(packed,
+              ElementsAre(0, 101, 0, 103, 104, 105, 106, 107, 108, 109));
+  packed(SeqView::Range{0, 5, 2}).pack(SeqView::View(values.data(), 3, -1));
+  EXPECT_THAT(packed, ElementsAre(102, 101, 101, 103, 100, 105, 106, 107, 108,
+                                  109));
+
+  // Overlapping views are staged
+  packed(SeqView::Range{2, 10}) = packed(SeqView::Range{0, 8});
+  EXPECT_THAT(packed, ElementsAre(102, 101, 102, 101, 101, 103, 100, 105, 106,
+                                  107));
+  std::vector<uint64_t> wide(8);
+  packed(SeqView::Range{2, 10}).unpack(SeqView::View(wide.data(), 8));
+  EXPECT_THAT(wide, ElementsAre(102, 101, 101, 103, 100, 105, 106, 107));
+}
+
+TEST(Packed, ReduceAndCompare) {
+  auto values = random_values<12>(5000);
+  auto bytes = pack_bits<12>(values);
+  SeqView::PackedView<12> packed(bytes.data(), values.size());
+  EXPECT_THAT(packed.reduce(uint64_t(0)),
+              Eq(std::accumulate(values.begin(), values.end(), uint64_t(0))));
+  EXPECT_THAT(packed.reduce(uint32_t(0),
+                            [](uint32_t acc, uint16_t value) {
+                              return std::max<uint32_t>(acc, value);
+                            }),
+              Eq(*std::max_element(values.begin(), values.end())));
+
+  auto below = packed < 2048;
+  auto above = packed > 2048;
+  ASSERT_THAT(below, SizeIs(values.size()));
+  for (uint64_t idx = 0; idx < values.size(); ++idx) {
+    EXPECT_THAT(below[idx], Eq(values[idx] < 2048));
+    EXPECT_THAT(above[idx], Eq(values[idx] > 2048));
+  }
+
+  auto small = packed(std::move(below));
+  uint64_t expected = 0;
+  for (auto value : values)
+    if (value < 2048) expected += value;
+  EXPECT_THAT(small.reduce(uint64_t(0)), Eq(expected));
+  uint64_t visited = 0;
+  small.for_each([&visited](uint16_t value) {
+    EXPECT_THAT(value, Lt(2048));
+    ++visited;
+  });
+  EXPECT_THAT(visited, Eq(small.size()));
+}
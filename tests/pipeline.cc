@@ -0,0 +1,80 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/pipeline.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Pipeline, ChunksCoverStridedView) {
+  uint64_t data[100];
+  std::iota(std::begin(data), std::end(data), 0);
+  SeqView::View view(data, 100);
+  auto sub = view(SeqView::Range{3, 100, -3});
+  std::vector<uint64_t> visited;
+  std::vector<uint64_t> sizes;
+  for (auto& chunk : SeqView::chunks(sub, 7)) {
+    sizes.push_back(chunk.size());
+    for (auto elem : chunk) visited.push_back(elem);
+  }
+  EXPECT_THAT(sizes, ElementsAre(7, 7, 7, 7, 5));
+  EXPECT_THAT(visited, ElementsAreArray(sub.begin(), sub.end()));
+}
+
+TEST(Pipeline, ChunksOfMaskedView) {
+  uint64_t data[] = {1, 3, 7, 5, 4, 2, 1, 3, 6, 8};
+  std::vector<uint8_t> mask{false, true, false, false, true,
+                            true,  true, true,  false, true};
+  SeqView::View view(data, 10);
+  std::vector<uint64_t> visited;
+  for (auto& chunk : SeqView::chunks(view(mask), 4))
+    for (auto elem : chunk) visited.push_back(elem);
+  EXPECT_THAT(visited, ElementsAre(3, 4, 2, 1, 3, 8));
+}
+
+TEST(Pipeline, FilterMapReduce) {
+  std::vector<int64_t> data(10000);
+  std::iota(data.begin(), data.end(), -5000);
+  SeqView::View view(data.data(), data.size());
+  auto sub = view(SeqView::StepRange(3));
+
+  int64_t expected = 0;
+  for (auto elem : sub)
+    if (elem % 2 == 0) expected += elem * elem;
+
+  auto even = SeqView::filter(SeqView::chunks(sub, 128),
+                              [](auto elem) { return elem % 2 == 0; });
+  auto squares =
+      SeqView::map(std::move(even), [](auto elem) { return elem * elem; });
+  EXPECT_THAT(SeqView::reduce(std::move(squares), int64_t(0), std::plus<>{}),
+              Eq(expected));
+}
+
+TEST(Pipeline, ThreadedStage) {
+  std::vector<uint32_t> data(50000);
+  std::iota(data.begin(), data.end(), 0);
+  SeqView::View view(data.data(), data.size());
+  auto doubled = SeqView::map(
+      SeqView::threaded(SeqView::chunks(view, 1000), 3),
+      [](auto elem) { return uint64_t(elem) * 2; });
+  auto total = SeqView::reduce(SeqView::threaded(std::move(doubled)),
+                               uint64_t(0), std::plus<>{});
+  EXPECT_THAT(total, Eq(uint64_t(49999) * 50000));
+}
+
+TEST(Pipeline, ThreadedStopsEarly) {
+  std::vector<uint32_t> data(50000);
+  SeqView::View view(data.data(), data.size());
+  uint64_t seen = 0;
+  for (auto& chunk : SeqView::threaded(SeqView::chunks(view, 100), 1)) {
+    seen += chunk.size();
+    if (seen >= 300) break;
+  }
+  EXPECT_THAT(seen, Eq(300));
+}
@@ -0,0 +1,74 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sequence_view/range.hpp>
+#include <sequence_view/rolling.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Rolling, SumAndMean) {
+  float data[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  auto windows = SeqView::rolling(SeqView::View(data, 8), 3);
+  EXPECT_THAT(windows.size(), Eq(6));
+  EXPECT_THAT(windows[2], ElementsAre(3, 4, 5));
+  float sums[6];
+  windows.sum(SeqView::View(sums, 6));
+  EXPECT_THAT(sums, ElementsAre(6, 9, 12, 15, 18, 21));
+  double means[6];
+  windows.mean(SeqView::View(means, 6));
+  EXPECT_THAT(means, ElementsAre(2, 3, 4, 5, 6, 7));
+}
+
+TEST(Rolling, StridedInputAndOutput) {
+  int32_t data[] = {5, 0, 1, 0, 4, 0, 2, 0, 3, 0};
+  SeqView::View view(data, 10);
+  auto windows = SeqView::rolling(view(SeqView::StepRange(2)), 2);
+  int64_t out[8] = {};
+  SeqView::View vo(out, 8);
+  auto backward = vo(SeqView::Range{0, 8, -2});
+  windows.min(backward);
+  EXPECT_THAT(out, ElementsAre(2, 0, 2, 0, 1, 0, 1, 0));
+  windows.max(backward);
+  EXPECT_THAT(out, ElementsAre(3, 0, 4, 0, 4, 0, 5, 0));
+  windows.sum(vo(SeqView::Range{1, 8, 2}));
+  EXPECT_THAT(out, ElementsAre(3, 6, 4, 5, 4, 6, 5, 5));
+}
+
+TEST(Rolling, MatchesNaiveWindows) {
+  std::vector<double> data(1000);
+  std::mt19937 gen(11);
+  std::normal_distribution<double> dist(100.0, 5.0);
+  for (auto& elem : data) elem = dist(gen);
+  SeqView::View view(data.data(), data.size());
+  auto windows = SeqView::rolling(view, 17);
+  std::vector<double> mins(windows.size()), maxs(windows.size()),
+      stddevs(windows.size());
+  windows.min(SeqView::View(mins.data(), mins.size()));
+  windows.max(SeqView::View(maxs.data(), maxs.size()));
+  windows.stddev(SeqView::View(stddevs.data(), stddevs.size()), 1);
+  for (uint64_t idx = 0; idx < windows.size(); ++idx) {
+    auto window = windows[idx];
+    EXPECT_THAT(mins[idx], Eq(*std::min_element(window.begin(), window.end())));
+    EXPECT_THAT(maxs[idx], Eq(*std::max_element(window.begin(), window.end())));
+    auto mean = std::accumulate(window.begin(), window.end(), 0.0) / 17;
+    double squares = 0.0;
+    for (auto elem : window) squares += (elem - mean) * (elem - mean);
+    EXPECT_THAT(stddevs[idx], DoubleNear(std::sqrt(squares / 16), 1e-9));
+  }
+}
+
+TEST(Rolling, MismatchedOutputIsIgnored) {
+  uint32_t data[] = {1, 2, 3, 4};
+  uint32_t out[] = {7, 7, 7, 7};
+  auto windows = SeqView::rolling(SeqView::View(data, 4), 2);
+  windows.sum(SeqView::View(out, 4));
+  EXPECT_THAT(out, Each(7));
+  EXPECT_THAT(SeqView::rolling(SeqView::View(data, 4), 5).size(), Eq(0));
+  EXPECT_THAT(SeqView::rolling(SeqView::View(data, 4), 0).size(), Eq(0));
+}
@@ -0,0 +1,79 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/scan.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Scan, InclusiveContiguous) {
+  int32_t data[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+  int32_t out[11];
+  std::vector<int32_t> expected(11);
+  std::inclusive_scan(std::begin(data), std::end(data), expected.begin());
+  SeqView::inclusive_scan(SeqView::View(data, 11), SeqView::View(out, 11));
+  EXPECT_THAT(out, ElementsAreArray(expected));
+}
+
+TEST(Scan, ExclusiveInPlace) {
+  float data[] = {1, 2, 3, 4, 5, 6, 7};
+  float expected[] = {10, 11, 13, 16, 20, 25, 31};
+  SeqView::View view(data, 7);
+  SeqView::exclusive_scan(view, view, 10);
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST(Scan, InclusiveCustomOperation) {
+  uint64_t data[] = {3, 1, 4, 1, 5, 9, 2};
+  uint64_t expected[] = {3, 3, 4, 4, 5, 9, 9};
+  SeqView::View view(data, 7);
+  SeqView::inclusive_scan(
+      view, view, [](auto lhs, auto rhs) { return std::max(lhs, rhs); });
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST(Scan, StridedIntoMasked) {
+  uint64_t data[] = {1, 0, 2, 0, 3, 0, 4, 0};
+  uint64_t out[] = {9, 9, 9, 9, 9, 9};
+  uint64_t expected[] = {1, 9, 3, 6, 9, 10};
+  std::vector<uint8_t> mask{true, false, true, true, false, true};
+  SeqView::View src(data, 8);
+  SeqView::View dst(out, 6);
+  SeqView::inclusive_scan(src(SeqView::StepRange(2)), dst(mask));
+  EXPECT_THAT(out, ElementsAreArray(expected));
+}
+
+TEST(Scan, ParallelMatchesSerial) {
+  std::vector<int32_t> data(10007);
+  std::iota(data.begin(), data.end(), -5000);
+  std::vector<int64_t> expected(data.size() / 3 + 1);
+  std::vector<int64_t> out(expected.size());
+  SeqView::View view(data.data(), data.size());
+  SeqView::View out_view(out.data(), out.size());
+  auto sub = view(SeqView::Range{0, 10007, -3});
+  std::exclusive_scan(sub.begin(), sub.end(), expected.begin(), int64_t(7));
+
+  SeqView::exclusive_scan(sub, out_view, 7, std::plus<>{},
+                          SeqView::Threads{4, 100});
+  EXPECT_THAT(out, ContainerEq(expected));
+
+  std::vector<int32_t> dense(data.size());
+  std::vector<int32_t> dense_expected(data.size());
+  std::inclusive_scan(data.begin(), data.end(), dense_expected.begin());
+  SeqView::inclusive_scan(view, SeqView::View(dense.data(), dense.size()),
+                          std::plus<>{}, SeqView::Threads{3, 100});
+  EXPECT_THAT(dense, ContainerEq(dense_expected));
+}
+
+TEST(Scan, DifferentSizeIsIgnored) {
+  uint64_t data[] = {1, 2, 3};
+  uint64_t out[] = {0, 0};
+  SeqView::inclusive_scan(SeqView::View(data, 3), SeqView::View(out, 2));
+  EXPECT_THAT(out, ElementsAre(0, 0));
+}
@@ -0,0 +1,94 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/sort.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Sort, SortWithNegativeStep) {
+  uint64_t data[] = {3, 6, 1, 5, 4, 3, 5, 1};
+  uint64_t expected[] = {5, 6, 4, 5, 3, 3, 1, 1};
+  SeqView::View view(data, 8);
+  SeqView::sort(view(SeqView::Range{0, 8, -2}));
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST(Sort, SortContiguousWithComparator) {
+  int32_t data[] = {3, -6, 1, 5, -4};
+  int32_t expected[] = {5, 3, 1, -4, -6};
+  SeqView::View view(data, 5);
+  SeqView::sort(view, std::greater<>{});
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST(Sort, RadixSortMatchesStdSort) {
+  std::vector<int64_t> data(4096);
+  std::mt19937_64 gen(42);
+  std::uniform_int_distribution<int64_t> dist(-1000000, 1000000);
+  for (auto& elem : data) elem = dist(gen);
+  auto expected = data;
+  std::sort(expected.begin() + 1, expected.end());
+  std::sort(expected.begin(), expected.end());
+
+  SeqView::View view(data.data(), data.size());
+  SeqView::sort(view);
+  EXPECT_THAT(data, ContainerEq(expected));
+}
+
+TEST(Sort, RadixSortStrided) {
+  std::vector<uint16_t> data(3000);
+  std::mt19937 gen(7);
+  for (auto& elem : data) elem = static_cast<uint16_t>(gen());
+  auto original = data;
+
+  SeqView::View view(data.data(), data.size());
+  auto sub = view(SeqView::StepRange(3));
+  SeqView::sort(sub);
+  EXPECT_TRUE(std::is_sorted(sub.begin(), sub.end()));
+  for (uint64_t idx = 0; idx < data.size(); ++idx) {
+    if (idx % 3 == 0) continue;
+    EXPECT_THAT(data[idx], Eq(original[idx]))
+        << fmt::format("Failed for idx {}", idx);
+  }
+}
+
+TEST(Sort, StableSortWithMask) {
+  std::pair<int, int> data[] = {{2, 0}, {1, 1}, {2, 2}, {0, 3}, {1, 4}, {0, 5}};
+  std::vector<uint8_t> mask{false, true, true, true, true, false};
+  std::pair<int, int> expected[] = {{2, 0}, {0, 3}, {1, 1},
+                                    {1, 4}, {2, 2}, {0, 5}};
+  SeqView::View view(data, 6);
+  SeqView::stable_sort(view(mask), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
+
+TEST(Sort, NthElementMedianOfEverySecond) {
+  uint64_t data[] = {9, 0, 7, 0, 1, 0, 8, 0, 3, 0};
+  SeqView::View view(data, 10);
+  auto sub = view(SeqView::StepRange(2));
+  SeqView::nth_element(sub, 2);
+  EXPECT_THAT(sub[2], Eq(7));
+  for (uint64_t idx = 0; idx < 2; ++idx) EXPECT_THAT(sub[idx], Le(7));
+  for (uint64_t idx = 3; idx < 5; ++idx) EXPECT_THAT(sub[idx], Ge(7));
+  for (uint64_t idx = 1; idx < 10; idx += 2) EXPECT_THAT(data[idx], Eq(0));
+}
+
+TEST(Sort, PartitionKeepsOrder) {
+  uint64_t data[] = {3, 6, 1, 5, 4, 3, 5, 1};
+  uint64_t expected[] = {3, 3, 1, 1, 4, 6, 5, 5};
+  SeqView::View view(data, 8);
+  auto split = SeqView::partition(view(SeqView::Range{1, 8, 2}),
+                                  [](auto elem) { return elem < 4; });
+  EXPECT_THAT(split, Eq(2));
+  EXPECT_THAT(data, ElementsAreArray(expected));
+}
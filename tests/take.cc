@@ -0,0 +1,104 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/take.hpp>
+#include <sequence_view/view.hpp>
+
+using namespace ::testing;
+
+TEST(Take, StridedViews) {
+  uint64_t data[] = {0, 10, 20, 30, 40, 50, 60, 70};
+  SeqView::View view(data, 8);
+  int32_t indices[] = {3, 0, 3, 7};
+  uint64_t out[4] = {};
+  SeqView::take(view, SeqView::View(indices, 4), SeqView::View(out, 4));
+  EXPECT_THAT(out, ElementsAre(30, 0, 30, 70));
+
+  auto backward = view(SeqView::Range{0, 8, -2});
+  SeqView::take(backward, SeqView::View(indices, 3), SeqView::View(out, 3));
+  EXPECT_THAT(out, ElementsAre(0, 60, 0, 70));
+}
+
+TEST(Take, OutOfRangeIndicesAreSkipped) {
+  float data[] = {1, 2, 3};
+  int64_t indices[] = {2, -1, 3, 0};
+  float out[] = {9, 9, 9, 9};
+  SeqView::take(SeqView::View(data, 3), SeqView::View(indices, 4),
+                SeqView::View(out, 4));
+  EXPECT_THAT(out, ElementsAre(3, 9, 9, 1));
+  SeqView::take(SeqView::View(data, 3), SeqView::View(indices, 4),
+                SeqView::View(out, 3));
+  EXPECT_THAT(out, ElementsAre(3, 9, 9, 1));
+}
+
+TEST(Take, MaskedViewsSelectOrResolveAll) {
+  std::vector<uint32_t> data(5000);
+  std::iota(data.begin(), data.end(), 0);
+  std::vector<uint8_t> mask(5000);
+  for (uint64_t idx = 0; idx < mask.size(); ++idx) mask[idx] = idx % 3 == 0;
+  SeqView::View view(data.data(), data.size());
+  auto masked = view(mask);
+
+  // Few lookups select positions one by one
+  uint64_t few[] = {0, 5, 1666};
+  uint32_t out[3];
+  SeqView::take(masked, SeqView::View(few, 3), SeqView::View(out, 3));
+  EXPECT_THAT(out, ElementsAre(0, 15, 4998));
+
+  // Many lookups resolve the whole mask once
+  std::vector<uint32_t> many(1000);
+  std::mt19937 gen(2);
+  for (auto& idx : many) idx = gen() % 1667;
+  std::vector<uint32_t> values(many.size());
+  SeqView::take(masked, SeqView::View(many.data(), many.size()),
+                SeqView::View(values.data(), values.size()));
+  for (uint64_t idx = 0; idx < many.size(); ++idx)
+    EXPECT_THAT(values[idx], Eq(masked[many[idx]]));
+}
+
+TEST(Take, PutInIndexOrder) {
+  double data[6] = {};
+  SeqView::View view(data, 6);
+  uint16_t indices[] = {1, 4, 1, 9};
+  double values[] = {1.5, 2.5, 3.5, 4.5};
+  SeqView::put(view(SeqView::StepRange(1)), SeqView::View(indices, 4),
+               SeqView::View(values, 4));
+  EXPECT_THAT(data, ElementsAre(0, 3.5, 0, 0, 2.5, 0));
+
+  std::vector<int64_t> large(1000, 0);
+  std::vector<uint64_t> positions(600);
+  std::vector<int64_t> stored(600);
+  for (uint64_t idx = 0; idx < positions.size(); ++idx) {
+    positions[idx] = (idx * 7) % 300;
+    stored[idx] = static_cast<int64_t>(idx);
+  }
+  SeqView::View vl(large.data(), large.size());
+  SeqView::put(vl(SeqView::Range{0, 1000, -1}),
+               SeqView::View(positions.data(), positions.size()),
+               SeqView::View(stored.data(), stored.size()));
+  // Every position is written twice, the later value stays
+  for (uint64_t idx = 300; idx < positions.size(); ++idx)
+    EXPECT_THAT(large[999 - positions[idx]], Eq(stored[idx]));
+}
+
+TEST(Take, FieldsOfRecords) {
+  struct Row {
+    int32_t key;
+    float value;
+  };
+  std::vector<Row> table{{7, 0.5f}, {8, 1.5f}, {9, 2.5f}};
+  auto values = SeqView::View<float>::field(table, &Row::value);
+  uint8_t rows[] = {2, 2, 0};
+  float out[3];
+  SeqView::take(values, SeqView::View(rows, 3), SeqView::View(out, 3));
+  EXPECT_THAT(out, ElementsAre(2.5f, 2.5f, 0.5f));
+  SeqView::put(values, SeqView::View(rows, 1), SeqView::View(out + 2, 1));
+  EXPECT_THAT(table[2].value, Eq(0.5f));
+  EXPECT_THAT(table[2].key, Eq(9));
+}
@@ -8,6 +8,7 @@
 #include <sequence_view/mask.hpp>
 #include <sequence_view/range.hpp>
 #include <sequence_view/view.hpp>
+#include <string>
 
 using namespace ::testing;
 
@@ -262,3 +263,121 @@ TEST(View, CascadeAssignViewDifferentSize) {
     EXPECT_THAT(elem, Eq(expected_unchanged[idx++]));
   }
 }
+
+TEST(View, SubViewOfElements) {
+  uint64_t data[20];
+  init_range(data, 20);
+  SeqView::View view(data, 20);
+  auto forward = view(SeqView::Range{2, 20, 3}).subview(1, 4);
+  EXPECT_THAT(forward, ElementsAre(5, 8, 11));
+  auto backward = view(SeqView::Range{0, 20, -3}).subview(1, 4);
+  EXPECT_THAT(backward, ElementsAre(15, 12, 9));
+  EXPECT_THAT(view.subview(5, 40), SizeIs(15));
+  EXPECT_THAT(view.subview(7, 3), SizeIs(0));
+}
+
+TEST(View, AssignValueRespectsStep) {
+  uint64_t data[] = {1, 2, 3, 4, 5, 6};
+  SeqView::View view(data, 6);
+  view(SeqView::Range{0, 6, -2}) = 0;
+  EXPECT_THAT(data, ElementsAre(0, 2, 0, 4, 0, 6));
+  std::vector<uint8_t> mask{false, true, false, true};
+  view(mask) = 9;
+  EXPECT_THAT(data, ElementsAre(0, 9, 0, 9, 0, 6));
+}
+
+TEST(View, AssignOverlappingShift) {
+  uint64_t data[10];
+  init_range(data, 10);
+  SeqView::View view(data, 10);
+  view(SeqView::Range{0, 8}) = view(SeqView::Range{2, 10});
+  EXPECT_THAT(data, ElementsAre(2, 3, 4, 5, 6, 7, 8, 9, 8, 9));
+  init_range(data, 10);
+  view(SeqView::Range{1, 10}) = view(SeqView::Range{0, 9});
+  EXPECT_THAT(data, ElementsAre(0, 0, 1, 2, 3, 4, 5, 6, 7, 8));
+
+  init_range(data, 10);
+  view(SeqView::Range{2, 10, 2}) = view(SeqView::Range{0, 8, 2});
+  EXPECT_THAT(data, ElementsAre(0, 1, 0, 3, 2, 5, 4, 7, 6, 9));
+  init_range(data, 10);
+  view(SeqView::Range{1, 9, 2}) = view(SeqView::Range{0, 8, 2});
+  EXPECT_THAT(data, ElementsAre(0, 0, 2, 2, 4, 4, 6, 6, 8, 9));
+
+  std::vector<std::string> words{"a", "b", "c", "d", "e"};
+  SeqView::View text(words.data(), words.size());
+  text(SeqView::Range{1, 5}) = text(SeqView::Range{0, 4});
+  EXPECT_THAT(words, ElementsAre("a", "a", "b", "c", "d"));
+}
+
+TEST(View, AssignOverlappingReversal) {
+  uint64_t data[10];
+  init_range(data, 10);
+  SeqView::View view(data, 10);
+  view(SeqView::Range{0, 10, -1}) = view;
+  EXPECT_THAT(data, ElementsAre(9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+  init_range(data, 10);
+  view(SeqView::Range{0, 10, -2}) = view(SeqView::Range{0, 10, 2});
+  EXPECT_THAT(data, ElementsAre(8, 1, 6, 3, 4, 5, 2, 7, 0, 9));
+  init_range(data, 10);
+  view(SeqView::Range{1, 10, -1}) = view(SeqView::Range{0, 9});
+  EXPECT_THAT(data, ElementsAre(0, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+TEST(View, AssignOverlappingStrideOrMask) {
+  uint64_t data[10];
+  init_range(data, 10);
+  SeqView::View view(data, 10);
+  view(SeqView::Range{0, 10, 2}) = view(SeqView::Range{0, 5});
+  EXPECT_THAT(data, ElementsAre(0, 1, 1, 3, 2, 5, 3, 7, 4, 9));
+
+  init_range(data, 10);
+  std::vector<uint8_t> target{false, false, true, true, true, true};
+  std::vector<uint8_t> source{false, true, true, true, true};
+  view(target) = view(source);
+  EXPECT_THAT(data, ElementsAre(0, 1, 1, 2, 3, 4, 6, 7, 8, 9));
+
+  init_range(data, 10);
+  view(target) = view(SeqView::Range{0, 8, 2});
+  EXPECT_THAT(data, ElementsAre(0, 1, 0, 2, 4, 6, 6, 7, 8, 9));
+}
+
+struct Sample {
+  uint16_t id;
+  float temp;
+  double pressure;
+};
+
+TEST(View, FieldOfRecords) {
+  std::vector<Sample> records;
+  for (uint16_t idx = 0; idx < 6; ++idx)
+    records.push_back({idx, idx * 1.5f, idx * 10.0});
+  auto temp = SeqView::View<float>::field(records, &Sample::temp);
+  EXPECT_THAT(temp.pitch(), Eq(static_cast<int64_t>(sizeof(Sample))));
+  EXPECT_FALSE(temp.contiguous());
+  EXPECT_THAT(temp, ElementsAre(0.0f, 1.5f, 3.0f, 4.5f, 6.0f, 7.5f));
+  EXPECT_THAT(temp[4], Eq(6.0f));
+  EXPECT_THAT(temp.end() - temp.begin(), Eq(6));
+
+  EXPECT_THAT(temp(SeqView::Range{1, 5}), ElementsAre(1.5f, 3.0f, 4.5f, 6.0f));
+  EXPECT_THAT(temp(SeqView::Range{0, 6, -2}), ElementsAre(6.0f, 3.0f, 0.0f));
+  EXPECT_THAT(temp(SeqView::Range{0, 6, -2}).subview(1, 3),
+              ElementsAre(3.0f, 0.0f));
+
+  auto below = temp < 4.0f;
+  EXPECT_THAT(below, ElementsAre(1, 1, 1, 0, 0, 0));
+  auto cold = temp(std::move(below));
+  EXPECT_THAT(cold, ElementsAre(0.0f, 1.5f, 3.0f));
+  cold = -1.0f;
+  EXPECT_THAT(temp, ElementsAre(-1.0f, -1.0f, -1.0f, 4.5f, 6.0f, 7.5f));
+
+  auto pressure = SeqView::View<double>::field(records, &Sample::pressure);
+  temp(SeqView::Range{0, 6, 2}) = 8.0f;
+  EXPECT_THAT(pressure, ElementsAre(0.0, 10.0, 20.0, 30.0, 40.0, 50.0));
+  EXPECT_THAT(records[2].temp, Eq(8.0f));
+  EXPECT_THAT(records[3].id, Eq(3));
+
+  const auto& frozen = records;
+  auto ids = SeqView::View<const uint16_t>::field(frozen, &Sample::id);
+  EXPECT_THAT(ids(SeqView::Range{3, 6}), ElementsAre(3, 4, 5));
+  EXPECT_THAT(ids.reshape(2, 3)(1, 2), Eq(5));
+}
@@ -0,0 +1,96 @@
+#include <fmt/format.h>
+#include <gmock/gmock-more-matchers.h>
+#include <gtest/gtest-matchers.h>
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <sequence_view/base-iterator.hpp>
+#include <sequence_view/mask.hpp>
+#include <sequence_view/range.hpp>
+#include <sequence_view/view.hpp>
+#include <sequence_view/zip.hpp>
+
+using namespace ::testing;
+
+TEST(Zip, ContiguousSharedIndex) {
+  float x[] = {1, 2, 3, 4};
+  float y[] = {10, 20, 30, 40};
+  double z[4];
+  SeqView::View vx(x, 4);
+  SeqView::View vy(y, 4);
+  SeqView::View vz(z, 4);
+  auto zipped = SeqView::zip(vx, vy, vz);
+  EXPECT_THAT(zipped.layout(), Eq(decltype(zipped)::Layout::Strided));
+  EXPECT_THAT(zipped.size(), Eq(4));
+  zipped.for_each([](auto a, auto b, auto& c) { c = a * b; });
+  EXPECT_THAT(z, ElementsAre(10, 40, 90, 160));
+}
+
+TEST(Zip, IterateTuplesWithNegativeStep) {
+  uint64_t x[] = {1, 2, 3, 4, 5, 6};
+  uint64_t y[] = {10, 20, 30, 40, 50, 60};
+  SeqView::View vx(x, 6);
+  SeqView::View vy(y, 6);
+  std::vector<std::pair<uint64_t, uint64_t>> visited;
+  for (auto [a, b] : SeqView::zip(vx(SeqView::Range{0, 6, -2}),
+                                  vy(SeqView::Range{0, 6, -2})))
+    visited.emplace_back(a, b);
+  EXPECT_THAT(visited, ElementsAre(Pair(5, 50), Pair(3, 30), Pair(1, 10)));
+}
+
+TEST(Zip, SameMaskSharesCursor) {
+  uint64_t x[] = {1, 2, 3, 4, 5};
+  uint64_t y[] = {10, 20, 30, 40, 50};
+  std::vector<uint8_t> mask{false, true, true, false, true};
+  SeqView::View vx(x, 5);
+  SeqView::View vy(y, 5);
+  auto zipped = SeqView::zip(vx(mask), vy(mask));
+  EXPECT_THAT(zipped.layout(), Eq(decltype(zipped)::Layout::Masked));
+  std::vector<uint64_t> sums;
+  for (auto [a, b] : zipped) sums.push_back(a + b);
+  EXPECT_THAT(sums, ElementsAre(22, 33, 55));
+  zipped.for_each([](auto& a, auto b) { a = b; });
+  EXPECT_THAT(x, ElementsAre(1, 20, 30, 4, 50));
+}
+
+TEST(Zip, MixedLayouts) {
+  uint64_t x[] = {1, 2, 3, 4, 5, 6};
+  uint64_t y[] = {10, 20, 30};
+  std::vector<uint8_t> mask{true, false, false, true, true, false};
+  SeqView::View vx(x, 6);
+  auto zipped = SeqView::zip(vx(mask), SeqView::View(y, 3));
+  EXPECT_THAT(zipped.layout(), Eq(decltype(zipped)::Layout::Mixed));
+  std::vector<uint64_t> products;
+  zipped.for_each([&](auto a, auto b) { products.push_back(a * b); });
+  EXPECT_THAT(products, ElementsAre(10, 80, 150));
+}
+
+TEST(Zip, DifferentSizesAreEmpty) {
+  uint64_t x[] = {1, 2, 3};
+  uint64_t y[] = {1, 2};
+  auto zipped = SeqView::zip(SeqView::View(x, 3), SeqView::View(y, 2));
+  EXPECT_THAT(zipped.size(), Eq(0));
+  EXPECT_TRUE(zipped.begin() == zipped.end());
+}
+
+TEST(Zip, FieldsOfRecords) {
+  struct Point {
+    int32_t x;
+    int32_t y;
+    int64_t sum;
+  };
+  std::vector<Point> points{{1, 10, 0}, {2, 20, 0}, {3, 30, 0}};
+  auto xs = SeqView::View<int32_t>::field(points, &Point::x);
+  auto ys = SeqView::View<int32_t>::field(points, &Point::y);
+  auto sums = SeqView::View<int64_t>::field(points, &Point::sum);
+  auto zipped = SeqView::zip(xs, ys, sums);
+  EXPECT_THAT(zipped.layout(), Eq(decltype(zipped)::Layout::Strided));
+  zipped.for_each([](auto x, auto y, auto& sum) { sum = x + y; });
+  EXPECT_THAT(sums, ElementsAre(11, 22, 33));
+  std::vector<uint8_t> mask{true, false, true};
+  auto masked = SeqView::zip(xs(mask), sums(mask));
+  EXPECT_THAT(masked.layout(), Eq(decltype(masked)::Layout::Masked));
+  std::vector<int64_t> seen;
+  for (auto [x, sum] : masked) seen.push_back(sum - x);
+  EXPECT_THAT(seen, ElementsAre(10, 30));
+}